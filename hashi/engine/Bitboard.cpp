@@ -0,0 +1,105 @@
+#include "Bitboard.h"
+#include <algorithm>
+
+namespace {
+
+// Maps each occupied cell of a 64x64 grid to an island position
+struct CellMap {
+    std::vector<int> cells = std::vector<int>(BITBOARD_MAX * BITBOARD_MAX, -1);
+
+    int& at(int x, int y) { return cells[x * BITBOARD_MAX + y]; }
+};
+
+// Bits above position p (exclusive)
+uint64_t bitsAbove(int p) {
+    return ~((uint64_t(2) << p) - 1);
+}
+
+void setBit(uint64_t& word, int bit, bool on) {
+    uint64_t mask = uint64_t(1) << bit;
+    word = on ? (word | mask) : (word & ~mask);
+}
+
+} // namespace
+
+bool fitsBitboard(const std::vector<Island>& islands) {
+    for (const auto& island : islands) {
+        if (island.x < 0 || island.x >= BITBOARD_MAX || island.y < 0 || island.y >= BITBOARD_MAX)
+            return false;
+    }
+    return true;
+}
+
+std::vector<Connection> computeConnectionsBitboard(const std::vector<Island>& islands) {
+    std::vector<uint64_t> rows(BITBOARD_MAX, 0);
+    std::vector<uint64_t> cols(BITBOARD_MAX, 0);
+    CellMap cells;
+    for (size_t i = 0; i < islands.size(); i++) {
+        setBit(rows[islands[i].x], islands[i].y, true);
+        setBit(cols[islands[i].y], islands[i].x, true);
+        cells.at(islands[i].x, islands[i].y) = static_cast<int>(i);
+    }
+
+    // (position of lower-id island, position of the other, connection)
+    struct Found { int first; int second; Connection conn; };
+    std::vector<Found> found;
+    found.reserve(islands.size() * 2);
+
+    auto link = [&](int i, int j, Orientation orientation) {
+        const Island& p = islands[i];
+        const Island& q = islands[j];
+        if (p.id == q.id) return;
+        if (p.id < q.id) found.push_back({i, j, {p.id, q.id, orientation, 0}});
+        else found.push_back({j, i, {q.id, p.id, orientation, 0}});
+    };
+
+    for (size_t i = 0; i < islands.size(); i++) {
+        const Island& island = islands[i];
+        uint64_t right = rows[island.x] & bitsAbove(island.y);
+        if (right) link(static_cast<int>(i), cells.at(island.x, __builtin_ctzll(right)), Orientation::HORIZONTAL);
+        uint64_t below = cols[island.y] & bitsAbove(island.x);
+        if (below) link(static_cast<int>(i), cells.at(__builtin_ctzll(below), island.y), Orientation::VERTICAL);
+    }
+
+    // computeConnections emits pairs in island-list order of both ends
+    std::sort(found.begin(), found.end(), [](const Found& l, const Found& r) {
+        return l.first != r.first ? l.first < r.first : l.second < r.second;
+    });
+
+    std::vector<Connection> result;
+    result.reserve(found.size());
+    for (const auto& f : found) result.push_back(f.conn);
+    return result;
+}
+
+std::vector<std::pair<int, int>> computeCrossingsBitboard(
+    const std::vector<Island>& islands,
+    const std::vector<Connection>& connections,
+    const std::vector<ConnectionEnds>& ends) {
+    // Vertical spans never overlap one another, so each cell has at most one
+    std::vector<uint64_t> verticalRows(BITBOARD_MAX, 0);
+    CellMap verticalAt;
+    for (size_t c = 0; c < connections.size(); c++) {
+        if (connections[c].orientation != Orientation::VERTICAL) continue;
+        const Island& a = islands[ends[c].a];
+        const Island& b = islands[ends[c].b];
+        for (uint64_t bits = spanMask(a.x, b.x); bits != 0; bits &= bits - 1) {
+            int x = __builtin_ctzll(bits);
+            setBit(verticalRows[x], a.y, true);
+            verticalAt.at(x, a.y) = static_cast<int>(c);
+        }
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+    for (size_t c = 0; c < connections.size(); c++) {
+        if (connections[c].orientation != Orientation::HORIZONTAL) continue;
+        const Island& a = islands[ends[c].a];
+        const Island& b = islands[ends[c].b];
+        for (uint64_t bits = verticalRows[a.x] & spanMask(a.y, b.y); bits != 0; bits &= bits - 1) {
+            int v = verticalAt.at(a.x, __builtin_ctzll(bits));
+            int h = static_cast<int>(c);
+            pairs.push_back({std::min(h, v), std::max(h, v)});
+        }
+    }
+    return pairs;
+}
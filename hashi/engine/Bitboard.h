@@ -0,0 +1,35 @@
+#pragma once
+#include "../model/Island.h"
+#include "../model/Connection.h"
+#include "../model/GraphIndex.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Load-time graph discovery on boards up to 64x64, where every row and every
+// column of islands fits one 64-bit word and neighbour and crossing searches
+// become bit scans. Levels that do not fit use the sorted sweeps in
+// GraphBuilder.cpp instead.
+const int BITBOARD_MAX = 64;
+
+// Bits strictly between columns (or rows) `from` and `to`
+inline uint64_t spanMask(int from, int to) {
+    int lo = from < to ? from : to;
+    int hi = from < to ? to : from;
+    uint64_t below = (hi >= 64) ? ~uint64_t(0) : ((uint64_t(1) << hi) - 1);
+    return below & ~((uint64_t(2) << lo) - 1);
+}
+
+bool fitsBitboard(const std::vector<Island>& islands);
+
+// Neighbour discovery by bit scan: the nearest island to the right and below
+// each island. Same connections, in the same order, as computeConnections.
+std::vector<Connection> computeConnectionsBitboard(const std::vector<Island>& islands);
+
+// Every pair of connections (i < j) that would cross, found by scanning each
+// horizontal span against a per-row mask of vertical spans
+std::vector<std::pair<int, int>> computeCrossingsBitboard(
+    const std::vector<Island>& islands,
+    const std::vector<Connection>& connections,
+    const std::vector<ConnectionEnds>& ends
+);
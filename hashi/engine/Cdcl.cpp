@@ -0,0 +1,302 @@
+#include "Cdcl.h"
+#include <algorithm>
+
+namespace {
+
+const double ACTIVITY_DECAY = 0.95;
+const double ACTIVITY_LIMIT = 1e100;
+const long RESTART_BASE = 100;
+
+// 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+long luby(long i) {
+    long size = 1;
+    int seq = 0;
+    while (size < i + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        seq--;
+        i = i % size;
+    }
+    return 1L << seq;
+}
+
+} // namespace
+
+int CdclSolver::addVariable() {
+    int var = static_cast<int>(assigns_.size());
+    assigns_.push_back(0);
+    polarity_.push_back(0);
+    level_.push_back(0);
+    reason_.push_back(-1);
+    seen_.push_back(0);
+    activity_.push_back(0.0);
+    heapPos_.push_back(-1);
+    watches_.emplace_back();
+    watches_.emplace_back();
+    heapInsert(var);
+    return var + 1;
+}
+
+bool CdclSolver::addClause(const std::vector<int>& literals) {
+    if (!ok_) return false;
+    backtrack(0);
+
+    // Drop literals false at level 0 and duplicates; skip satisfied clauses
+    std::vector<Lit> lits;
+    lits.reserve(literals.size());
+    for (int dimacs : literals) lits.push_back(toLit(dimacs));
+    std::sort(lits.begin(), lits.end());
+    std::vector<Lit> kept;
+    for (std::size_t i = 0; i < lits.size(); i++) {
+        if (i > 0 && lits[i] == lits[i - 1]) continue;
+        if (i > 0 && lits[i] == (lits[i - 1] ^ 1)) return true;   // tautology
+        int v = value(lits[i]);
+        if (v > 0) return true;
+        if (v == 0) kept.push_back(lits[i]);
+    }
+
+    if (kept.empty()) return ok_ = false;
+    if (kept.size() == 1) {
+        enqueue(kept[0], -1);
+        return ok_ = (propagate() == -1);
+    }
+    clauses_.push_back({std::move(kept), false});
+    attach(static_cast<int>(clauses_.size()) - 1);
+    return true;
+}
+
+CdclSolver::Result CdclSolver::solve(long maxConflicts) {
+    if (!ok_) return Result::Unsatisfiable;
+    backtrack(0);
+
+    long restarts = 0;
+    long restartLimit = RESTART_BASE * luby(restarts);
+    long sinceRestart = 0;
+    long budget = maxConflicts;
+
+    while (true) {
+        int conflict = propagate();
+        if (conflict >= 0) {
+            conflicts_++;
+            sinceRestart++;
+            if (decisionLevel() == 0) {
+                ok_ = false;
+                return Result::Unsatisfiable;
+            }
+
+            std::vector<Lit> learnt;
+            int backtrackLevel = 0;
+            analyze(conflict, learnt, backtrackLevel);
+            backtrack(backtrackLevel);
+            if (learnt.size() == 1) {
+                enqueue(learnt[0], -1);
+            } else {
+                clauses_.push_back({learnt, true});
+                int index = static_cast<int>(clauses_.size()) - 1;
+                attach(index);
+                enqueue(learnt[0], index);
+            }
+            bumpBy_ /= ACTIVITY_DECAY;
+
+            if (budget >= 0 && --budget < 0) {
+                backtrack(0);
+                return Result::Unknown;
+            }
+            if (sinceRestart >= restartLimit) {
+                backtrack(0);
+                restartLimit = RESTART_BASE * luby(++restarts);
+                sinceRestart = 0;
+            }
+            continue;
+        }
+
+        Lit next = pickBranch();
+        if (next < 0) {
+            model_.assign(assigns_.size(), false);
+            for (std::size_t v = 0; v < assigns_.size(); v++) model_[v] = assigns_[v] > 0;
+            backtrack(0);
+            return Result::Satisfiable;
+        }
+        decisions_++;
+        levelStart_.push_back(static_cast<int>(trail_.size()));
+        enqueue(next, -1);
+    }
+}
+
+void CdclSolver::enqueue(Lit lit, int reason) {
+    int var = varOf(lit);
+    assigns_[var] = (lit & 1) ? -1 : 1;
+    level_[var] = decisionLevel();
+    reason_[var] = reason;
+    trail_.push_back(lit);
+}
+
+// Returns the index of a conflicting clause, or -1
+int CdclSolver::propagate() {
+    while (propagated_ < trail_.size()) {
+        Lit falseLit = trail_[propagated_++] ^ 1;
+        propagations_++;
+        std::vector<int>& watching = watches_[falseLit];
+
+        std::size_t keep = 0;
+        for (std::size_t i = 0; i < watching.size(); i++) {
+            int index = watching[i];
+            std::vector<Lit>& lits = clauses_[index].lits;
+            if (lits[0] == falseLit) std::swap(lits[0], lits[1]);
+
+            if (value(lits[0]) > 0) {
+                watching[keep++] = index;
+                continue;
+            }
+
+            // Move the watch to any literal that is not false
+            bool moved = false;
+            for (std::size_t k = 2; k < lits.size(); k++) {
+                if (value(lits[k]) >= 0) {
+                    std::swap(lits[1], lits[k]);
+                    watches_[lits[1]].push_back(index);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            watching[keep++] = index;
+            if (value(lits[0]) < 0) {
+                for (i++; i < watching.size(); i++) watching[keep++] = watching[i];
+                watching.resize(keep);
+                propagated_ = trail_.size();
+                return index;
+            }
+            enqueue(lits[0], index);
+        }
+        watching.resize(keep);
+    }
+    return -1;
+}
+
+// First-UIP learning: resolves the conflict back along the current level
+// until one literal of that level remains
+void CdclSolver::analyze(int conflict, std::vector<Lit>& learnt, int& backtrackLevel) {
+    learnt.assign(1, 0);   // slot for the asserting literal
+    int pending = 0;
+    Lit lit = -1;
+    int index = static_cast<int>(trail_.size()) - 1;
+    int clause = conflict;
+
+    do {
+        const std::vector<Lit>& lits = clauses_[clause].lits;
+        for (std::size_t k = (lit == -1) ? 0 : 1; k < lits.size(); k++) {
+            int var = varOf(lits[k]);
+            if (seen_[var] || level_[var] == 0) continue;
+            seen_[var] = 1;
+            bump(var);
+            if (level_[var] >= decisionLevel()) pending++;
+            else learnt.push_back(lits[k]);
+        }
+        while (!seen_[varOf(trail_[index])]) index--;
+        lit = trail_[index--];
+        clause = reason_[varOf(lit)];
+        seen_[varOf(lit)] = 0;
+        pending--;
+    } while (pending > 0);
+    learnt[0] = lit ^ 1;
+
+    // Watch the deepest remaining literal second so the clause is asserting
+    backtrackLevel = 0;
+    for (std::size_t k = 1; k < learnt.size(); k++) {
+        if (level_[varOf(learnt[k])] > backtrackLevel) {
+            backtrackLevel = level_[varOf(learnt[k])];
+            std::swap(learnt[1], learnt[k]);
+        }
+    }
+    for (Lit l : learnt) seen_[varOf(l)] = 0;
+}
+
+void CdclSolver::backtrack(int level) {
+    if (decisionLevel() <= level) return;
+    for (int i = static_cast<int>(trail_.size()) - 1; i >= levelStart_[level]; i--) {
+        int var = varOf(trail_[i]);
+        polarity_[var] = assigns_[var] > 0;
+        assigns_[var] = 0;
+        reason_[var] = -1;
+        if (heapPos_[var] < 0) heapInsert(var);
+    }
+    trail_.resize(levelStart_[level]);
+    levelStart_.resize(level);
+    propagated_ = trail_.size();
+}
+
+void CdclSolver::attach(int clause) {
+    const std::vector<Lit>& lits = clauses_[clause].lits;
+    watches_[lits[0]].push_back(clause);
+    watches_[lits[1]].push_back(clause);
+}
+
+CdclSolver::Lit CdclSolver::pickBranch() {
+    while (!heap_.empty()) {
+        int var = heapPop();
+        if (assigns_[var] == 0) return 2 * var + (polarity_[var] ? 0 : 1);
+    }
+    return -1;
+}
+
+void CdclSolver::bump(int var) {
+    activity_[var] += bumpBy_;
+    if (activity_[var] > ACTIVITY_LIMIT) {
+        for (double& a : activity_) a /= ACTIVITY_LIMIT;
+        bumpBy_ /= ACTIVITY_LIMIT;
+    }
+    if (heapPos_[var] >= 0) heapUp(heapPos_[var]);
+}
+
+void CdclSolver::heapInsert(int var) {
+    heapPos_[var] = static_cast<int>(heap_.size());
+    heap_.push_back(var);
+    heapUp(heapPos_[var]);
+}
+
+int CdclSolver::heapPop() {
+    int top = heap_[0];
+    heapPos_[top] = -1;
+    int last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        heap_[0] = last;
+        heapPos_[last] = 0;
+        heapDown(0);
+    }
+    return top;
+}
+
+void CdclSolver::heapUp(int pos) {
+    int var = heap_[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (activity_[heap_[parent]] >= activity_[var]) break;
+        heap_[pos] = heap_[parent];
+        heapPos_[heap_[pos]] = pos;
+        pos = parent;
+    }
+    heap_[pos] = var;
+    heapPos_[var] = pos;
+}
+
+void CdclSolver::heapDown(int pos) {
+    int var = heap_[pos];
+    int size = static_cast<int>(heap_.size());
+    while (true) {
+        int child = 2 * pos + 1;
+        if (child >= size) break;
+        if (child + 1 < size && activity_[heap_[child + 1]] > activity_[heap_[child]]) child++;
+        if (activity_[heap_[child]] <= activity_[var]) break;
+        heap_[pos] = heap_[child];
+        heapPos_[heap_[pos]] = pos;
+        pos = child;
+    }
+    heap_[pos] = var;
+    heapPos_[var] = pos;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Small, self-contained CDCL SAT solver: two-watched-literal propagation,
+// first-UIP clause learning, VSIDS branching with phase saving and Luby
+// restarts. Clauses may be added between calls to solve(), and learnt
+// clauses are kept, so a formula can be refined incrementally.
+//
+// Literals use the DIMACS convention: variable v (from 1) is +v, its
+// negation -v.
+class CdclSolver {
+public:
+    enum class Result { Satisfiable, Unsatisfiable, Unknown };
+
+    int addVariable();
+    int variables() const { return static_cast<int>(assigns_.size()); }
+
+    // Returns false once the formula is known to be unsatisfiable
+    bool addClause(const std::vector<int>& literals);
+
+    // Unknown only if maxConflicts (when >= 0) ran out first
+    Result solve(long maxConflicts = -1);
+
+    // Assignment of the last satisfying model
+    bool modelValue(int variable) const { return model_[variable - 1]; }
+
+    int clauses() const { return static_cast<int>(clauses_.size()); }
+    long conflicts() const { return conflicts_; }
+    long decisions() const { return decisions_; }
+    long propagations() const { return propagations_; }
+
+private:
+    // Internal literal: 2 * variable index + 1 if negated
+    using Lit = int;
+
+    struct Clause {
+        std::vector<Lit> lits;   // lits[0] and lits[1] are watched
+        bool learnt;
+    };
+
+    static Lit toLit(int dimacs) { return dimacs > 0 ? 2 * (dimacs - 1) : 2 * (-dimacs - 1) + 1; }
+    static int varOf(Lit lit) { return lit >> 1; }
+
+    // 1 true, -1 false, 0 unassigned
+    int value(Lit lit) const {
+        int v = assigns_[varOf(lit)];
+        return (lit & 1) ? -v : v;
+    }
+
+    int decisionLevel() const { return static_cast<int>(levelStart_.size()); }
+    void enqueue(Lit lit, int reason);
+    int propagate();
+    void analyze(int conflict, std::vector<Lit>& learnt, int& backtrackLevel);
+    void backtrack(int level);
+    void attach(int clause);
+    Lit pickBranch();
+
+    void bump(int var);
+    void heapInsert(int var);
+    int heapPop();
+    void heapUp(int pos);
+    void heapDown(int pos);
+
+    std::vector<Clause> clauses_;
+    std::vector<std::vector<int>> watches_;   // [lit] clauses watching lit
+    std::vector<signed char> assigns_;
+    std::vector<char> polarity_;             // last value, reused on branching
+    std::vector<int> level_;
+    std::vector<int> reason_;                // clause index, or -1
+    std::vector<Lit> trail_;
+    std::vector<int> levelStart_;            // trail size at each decision
+    std::size_t propagated_ = 0;
+    std::vector<char> seen_;
+    std::vector<bool> model_;
+    bool ok_ = true;
+
+    std::vector<double> activity_;
+    double bumpBy_ = 1.0;
+    std::vector<int> heap_;                  // max-heap of variables by activity
+    std::vector<int> heapPos_;               // -1 when not in the heap
+
+    long conflicts_ = 0;
+    long decisions_ = 0;
+    long propagations_ = 0;
+};
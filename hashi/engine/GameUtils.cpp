@@ -1,6 +1,48 @@
 #include "GameUtils.h"
-#include <queue>
-#include <unordered_set>
+#include "Profiler.h"
+#include "ScratchArena.h"
+
+namespace {
+
+int islandPosition(const GameState& state, int id) {
+    // Levels usually number islands 1..N in order
+    if (id >= 1 && id <= static_cast<int>(state.islands.size()) && state.islands[id - 1].id == id)
+        return id - 1;
+    for (size_t i = 0; i < state.islands.size(); i++)
+        if (state.islands[i].id == id) return static_cast<int>(i);
+    return -1;
+}
+
+// Breadth-first search along bridged connections from island position
+// `start`, marking each island reached in `visited`. Returns true as soon as
+// `target` is reached; pass -1 to flood the whole component.
+bool bridgedSearch(const GameState& state, int start, int target,
+                   std::pmr::vector<char>& visited, std::pmr::memory_resource* scratch) {
+    std::pmr::vector<int> queue(scratch);
+    queue.reserve(state.islands.size());
+    queue.push_back(start);
+    visited[start] = 1;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int curr = queue[head];
+        const IslandLinks& links = state.index->links[curr];
+        for (int k = 0; k < links.count; k++) {
+            int c = links.connections[k];
+            if (state.connections[c].bridges == 0) continue;
+
+            const ConnectionEnds& ends = state.index->ends[c];
+            int next = (ends.a == curr) ? ends.b : ends.a;
+            if (visited[next]) continue;
+            if (next == target) return true;
+
+            visited[next] = 1;
+            queue.push_back(next);
+        }
+    }
+    return false;
+}
+
+} // namespace
 
 const Island* findIsland(const GameState& state, int id) {
     for (const auto& i : state.islands)
@@ -9,52 +51,34 @@ const Island* findIsland(const GameState& state, int id) {
 }
 
 int currentDegree(const GameState& state, int islandId) {
-    int sum = 0;
-    for (const auto& c : state.connections) {
-        if (c.islandA == islandId || c.islandB == islandId)
-            sum += c.bridges;
-    }
-    return sum;
+    HASHI_PROFILE_SCOPE(ProfilePoint::CurrentDegree);
+    int pos = islandPosition(state, islandId);
+    if (pos < 0) return 0;
+
+    return state.progress.degree[pos];
 }
 
 bool isReachable(const GameState& state, int fromId, int toId) {
+    HASHI_PROFILE_SCOPE(ProfilePoint::IsReachable);
     if (fromId == toId) return true;
 
-    std::queue<int> q;
-    std::unordered_set<int> visited;
-    
-    q.push(fromId);
-    visited.insert(fromId);
-
-    while (!q.empty()) {
-        int curr = q.front();
-        q.pop();
+    int from = islandPosition(state, fromId);
+    int to = islandPosition(state, toId);
+    if (from < 0 || to < 0) return false;
 
-        for (const auto& conn : state.connections) {
-            if (conn.bridges == 0) continue;
-
-            int neighborId = -1;
-            if (conn.islandA == curr) neighborId = conn.islandB;
-            else if (conn.islandB == curr) neighborId = conn.islandA;
-
-            if (neighborId != -1 && visited.find(neighborId) == visited.end()) {
-                if (neighborId == toId) return true;
-                visited.insert(neighborId);
-                q.push(neighborId);
-            }
-        }
-    }
-    return false;
+    ScratchScope scope;
+    std::pmr::vector<char> visited(state.islands.size(), 0, scope.resource());
+    return bridgedSearch(state, from, to, visited, scope.resource());
 }
 
 bool validateConnectivity(const GameState& state) {
     if (state.islands.empty()) return true;
 
-    int baseIslandId = state.islands[0].id;
-    for (const auto& island : state.islands) {
-        if (!isReachable(state, baseIslandId, island.id)) {
-            return false;
-        }
-    }
+    // A single flood fill from the first island must reach every island
+    ScratchScope scope;
+    std::pmr::vector<char> visited(state.islands.size(), 0, scope.resource());
+    bridgedSearch(state, 0, -1, visited, scope.resource());
+    for (char v : visited)
+        if (!v) return false;
     return true;
-}
\ No newline at end of file
+}
@@ -1,54 +1,240 @@
 #include "GraphBuilder.h"
-#include <algorithm>
+#include "Bitboard.h"
+#include "Profiler.h"
+#include "SolveTracker.h"
+#include "SpatialIndex.h"
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
-std::vector<Connection> computeConnections(const std::vector<Island>& islands) {
-    std::vector<Connection> result;
+namespace {
+
+// Positions of the islands sorted by row then column (byRow) or by column
+// then row; neighbours in that order are exactly the unblocked spans
+std::vector<int> sortedPositions(const std::vector<Island>& islands, bool byRow) {
+    std::vector<int> order(islands.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int l, int r) {
+        const Island& a = islands[l];
+        const Island& b = islands[r];
+        if (byRow) return a.x != b.x ? a.x < b.x : a.y < b.y;
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    return order;
+}
 
-    for (const auto& a : islands) {
-        for (const auto& b : islands) {
-            if (a.id >= b.id) continue;
-
-            // Horizontal connections (same row)
-            if (a.x == b.x) {
-                bool blocked = false;
-                for (const auto& c : islands) {
-                    if (c.x == a.x &&
-                        c.y > std::min(a.y, b.y) &&
-                        c.y < std::max(a.y, b.y)) {
-                        blocked = true;
-                        break;
-                    }
-                }
-                if (!blocked) {
-                    result.push_back({
-                        a.id, b.id,
-                        Orientation::HORIZONTAL,
-                        0
-                    });
-                }
-            }
-
-            // Vertical connections (same column)
-            if (a.y == b.y) {
-                bool blocked = false;
-                for (const auto& c : islands) {
-                    if (c.y == a.y &&
-                        c.x > std::min(a.x, b.x) &&
-                        c.x < std::max(a.x, b.x)) {
-                        blocked = true;
-                        break;
-                    }
-                }
-                if (!blocked) {
-                    result.push_back({
-                        a.id, b.id,
-                        Orientation::VERTICAL,
-                        0
-                    });
-                }
-            }
+// The runtime counterpart of forEachConnection: O(N log N) instead of
+// O(N^3), emitting the same connections in the same order
+std::vector<Connection> computeConnectionsSorted(const std::vector<Island>& islands) {
+    struct Span {
+        int first;      // position of the island with the smaller id
+        int second;
+        Orientation orientation;
+    };
+    std::vector<Span> spans;
+    for (bool byRow : {true, false}) {
+        std::vector<int> order = sortedPositions(islands, byRow);
+        for (size_t k = 1; k < order.size(); k++) {
+            int p = order[k - 1];
+            int q = order[k];
+            bool aligned = byRow ? islands[p].x == islands[q].x : islands[p].y == islands[q].y;
+            if (!aligned || islands[p].id == islands[q].id) continue;
+            if (islands[p].id > islands[q].id) std::swap(p, q);
+            spans.push_back({p, q, byRow ? Orientation::HORIZONTAL : Orientation::VERTICAL});
         }
     }
 
+    // forEachConnection visits pairs by the positions of their lower and
+    // higher id islands
+    std::sort(spans.begin(), spans.end(), [](const Span& l, const Span& r) {
+        return l.first != r.first ? l.first < r.first : l.second < r.second;
+    });
+    std::vector<Connection> result;
+    result.reserve(spans.size());
+    for (const Span& span : spans)
+        result.push_back({islands[span.first].id, islands[span.second].id, span.orientation, 0});
     return result;
-}
\ No newline at end of file
+}
+
+// The runtime counterpart of forEachCrossing: sweeps down the rows keeping
+// the vertical spans open on the current row ordered by column, so each
+// horizontal span finds its crossings with one range lookup.
+// O(C log C + crossings).
+std::vector<std::pair<int, int>> computeCrossingsSweep(const std::vector<Island>& islands,
+                                                       const std::vector<Connection>& connections,
+                                                       const std::vector<ConnectionEnds>& ends) {
+    struct Span {
+        int line;       // row of a horizontal span, column of a vertical one
+        int low;        // exclusive range across the span
+        int high;
+        int connection;
+    };
+    std::vector<Span> horizontal;
+    std::vector<Span> vertical;
+    for (size_t c = 0; c < connections.size(); c++) {
+        const Island& a = islands[ends[c].a];
+        const Island& b = islands[ends[c].b];
+        int connection = static_cast<int>(c);
+        if (connections[c].orientation == Orientation::HORIZONTAL)
+            horizontal.push_back({a.x, std::min(a.y, b.y), std::max(a.y, b.y), connection});
+        else
+            vertical.push_back({a.y, std::min(a.x, b.x), std::max(a.x, b.x), connection});
+    }
+
+    auto byLine = [](const Span& l, const Span& r) { return l.line < r.line; };
+    auto byLow = [](const Span& l, const Span& r) { return l.low < r.low; };
+    auto byHigh = [](const Span& l, const Span& r) { return l.high < r.high; };
+    std::sort(horizontal.begin(), horizontal.end(), byLine);
+    std::vector<Span> opening = vertical;
+    std::sort(opening.begin(), opening.end(), byLow);
+    std::sort(vertical.begin(), vertical.end(), byHigh);
+
+    // (column, connection) of the vertical spans strictly above and below
+    // the current row
+    std::set<std::pair<int, int>> open;
+    size_t nextOpen = 0;
+    size_t nextClose = 0;
+    std::vector<std::pair<int, int>> pairs;
+    for (const Span& h : horizontal) {
+        for (; nextOpen < opening.size() && opening[nextOpen].low < h.line; nextOpen++)
+            open.insert({opening[nextOpen].line, opening[nextOpen].connection});
+        for (; nextClose < vertical.size() && vertical[nextClose].high <= h.line; nextClose++)
+            open.erase({vertical[nextClose].line, vertical[nextClose].connection});
+
+        auto it = open.upper_bound({h.low, std::numeric_limits<int>::max()});
+        for (; it != open.end() && it->first < h.high; ++it)
+            pairs.push_back({std::min(h.connection, it->second), std::max(h.connection, it->second)});
+    }
+    return pairs;
+}
+
+} // namespace
+
+std::vector<Connection> computeConnections(const std::vector<Island>& islands) {
+    HASHI_PROFILE_SCOPE(ProfilePoint::ComputeConnections);
+    if (fitsBitboard(islands)) return computeConnectionsBitboard(islands);
+    return computeConnectionsSorted(islands);
+}
+
+bool isValidIslandList(const std::vector<Island>& islands) {
+    if (islands.size() > MAX_LEVEL_ISLANDS) return false;
+    std::unordered_set<int> ids;
+    for (const auto& island : islands) {
+        if (island.requiredDegree < 1 || island.requiredDegree > 8) return false;
+        if (island.x < -MAX_COORDINATE || island.x > MAX_COORDINATE ||
+            island.y < -MAX_COORDINATE || island.y > MAX_COORDINATE) {
+            return false;
+        }
+        if (!ids.insert(island.id).second) return false;
+    }
+
+    // Two islands on one cell end up next to each other in row-major order
+    std::vector<int> order = sortedPositions(islands, true);
+    for (size_t k = 1; k < order.size(); k++) {
+        const Island& a = islands[order[k - 1]];
+        const Island& b = islands[order[k]];
+        if (a.x == b.x && a.y == b.y) return false;
+    }
+    return true;
+}
+
+bool isValidLevelGraph(const std::vector<Island>& islands,
+                       const std::vector<Connection>& connections) {
+    if (!isValidIslandList(islands)) return false;
+    std::unordered_map<int, int> position;
+    for (size_t i = 0; i < islands.size(); i++)
+        position[islands[i].id] = static_cast<int>(i);
+
+    // Rank of each island in row-major and column-major order: a span is
+    // unblocked exactly when its two ends are neighbours in one of them
+    std::vector<int> rowRank(islands.size());
+    std::vector<int> columnRank(islands.size());
+    std::vector<int> order = sortedPositions(islands, true);
+    for (size_t k = 0; k < order.size(); k++) rowRank[order[k]] = static_cast<int>(k);
+    order = sortedPositions(islands, false);
+    for (size_t k = 0; k < order.size(); k++) columnRank[order[k]] = static_cast<int>(k);
+
+    // One bit per side (left, right, up, down) already taken
+    std::vector<unsigned char> sides(islands.size(), 0);
+    for (const auto& conn : connections) {
+        auto a = position.find(conn.islandA);
+        auto b = position.find(conn.islandB);
+        if (a == position.end() || b == position.end() || a->second == b->second) return false;
+        if (conn.bridges < 0 || conn.bridges > 2) return false;
+
+        int first = a->second;
+        int second = b->second;
+        bool horizontal = conn.orientation == Orientation::HORIZONTAL;
+        const std::vector<int>& rank = horizontal ? rowRank : columnRank;
+        bool aligned = horizontal ? islands[first].x == islands[second].x
+                                  : islands[first].y == islands[second].y;
+        if (!aligned || std::abs(rank[first] - rank[second]) != 1) return false;
+
+        if (rank[first] > rank[second]) std::swap(first, second);
+        unsigned char towardSecond = horizontal ? 2 : 8;
+        unsigned char towardFirst = horizontal ? 1 : 4;
+        if ((sides[first] & towardSecond) || (sides[second] & towardFirst)) return false;
+        sides[first] |= towardSecond;
+        sides[second] |= towardFirst;
+    }
+    return true;
+}
+
+GraphIndex computeGraphIndex(const std::vector<Island>& islands,
+                             const std::vector<Connection>& connections) {
+    GraphIndex index;
+
+    std::unordered_map<int, int> position;
+    for (size_t i = 0; i < islands.size(); i++)
+        position[islands[i].id] = static_cast<int>(i);
+
+    index.links.assign(islands.size(), IslandLinks{0, {-1, -1, -1, -1}});
+    index.ends.reserve(connections.size());
+    for (size_t c = 0; c < connections.size(); c++) {
+        ConnectionEnds ends{position.at(connections[c].islandA),
+                            position.at(connections[c].islandB)};
+        index.ends.push_back(ends);
+        for (int end : {ends.a, ends.b}) {
+            IslandLinks& links = index.links[end];
+            if (links.count == 4) throw std::invalid_argument("island with more than four connections");
+            links.connections[links.count++] = static_cast<int>(c);
+        }
+    }
+
+    // Crossing pairs, flattened into per-connection lists
+    std::vector<std::pair<int, int>> pairs;
+    if (fitsBitboard(islands)) {
+        pairs = computeCrossingsBitboard(islands, connections, index.ends);
+    } else {
+        pairs = computeCrossingsSweep(islands, connections, index.ends);
+    }
+
+    index.conflictStart.assign(connections.size() + 1, 0);
+    for (const auto& p : pairs) {
+        index.conflictStart[p.first + 1]++;
+        index.conflictStart[p.second + 1]++;
+    }
+    for (size_t c = 0; c < connections.size(); c++)
+        index.conflictStart[c + 1] += index.conflictStart[c];
+
+    index.conflictList.resize(pairs.size() * 2);
+    std::vector<int> fill(index.conflictStart.begin(), index.conflictStart.end() - 1);
+    for (const auto& p : pairs) {
+        index.conflictList[fill[p.first]++] = p.second;
+        index.conflictList[fill[p.second]++] = p.first;
+    }
+
+    return index;
+}
+
+void loadLevel(GameState& state, std::vector<Island> islands) {
+    state.islands = std::move(islands);
+    state.connections = computeConnections(state.islands);
+    state.index = std::make_shared<const GraphIndex>(computeGraphIndex(state.islands, state.connections));
+    buildSpatialIndex(state);
+    rebuildProgress(state);
+}
@@ -1,8 +1,125 @@
 #pragma once
 #include "../model/Island.h"
 #include "../model/Connection.h"
+#include "../model/GameState.h"
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 
+// The graph construction rules are written as constexpr templates over any
+// indexable container, which builds the built-in levels from std::array at
+// compile time. They are quadratic or worse, so runtime levels use the
+// sorted sweeps in GraphBuilder.cpp (or the bitboard), which produce the
+// same connections in the same order.
+
+template <typename Islands>
+constexpr bool rowBlocked(const Islands& islands, const Island& a, const Island& b) {
+    for (std::size_t k = 0; k < islands.size(); k++) {
+        const Island& c = islands[k];
+        if (c.x == a.x && c.y > std::min(a.y, b.y) && c.y < std::max(a.y, b.y))
+            return true;
+    }
+    return false;
+}
+
+template <typename Islands>
+constexpr bool columnBlocked(const Islands& islands, const Island& a, const Island& b) {
+    for (std::size_t k = 0; k < islands.size(); k++) {
+        const Island& c = islands[k];
+        if (c.y == a.y && c.x > std::min(a.x, b.x) && c.x < std::max(a.x, b.x))
+            return true;
+    }
+    return false;
+}
+
+// Calls emit(Connection) for every unblocked island pair, in connection order
+template <typename Islands, typename Emit>
+constexpr void forEachConnection(const Islands& islands, Emit&& emit) {
+    for (std::size_t i = 0; i < islands.size(); i++) {
+        for (std::size_t j = 0; j < islands.size(); j++) {
+            const Island& a = islands[i];
+            const Island& b = islands[j];
+            if (a.id >= b.id) continue;
+
+            // Horizontal connections (same row)
+            if (a.x == b.x && !rowBlocked(islands, a, b))
+                emit(Connection{a.id, b.id, Orientation::HORIZONTAL, 0});
+
+            // Vertical connections (same column)
+            if (a.y == b.y && !columnBlocked(islands, a, b))
+                emit(Connection{a.id, b.id, Orientation::VERTICAL, 0});
+        }
+    }
+}
+
+template <typename Islands>
+constexpr int islandIndexOf(const Islands& islands, int id) {
+    for (std::size_t i = 0; i < islands.size(); i++)
+        if (islands[i].id == id) return static_cast<int>(i);
+    return -1;
+}
+
+// Whether bridges on a (a1-a2) and b (b1-b2) would cross mid-span
+constexpr bool segmentsCross(const Island& a1, const Island& a2, Orientation ao,
+                             const Island& b1, const Island& b2, Orientation bo) {
+    if (ao == bo) return false;
+    if (ao == Orientation::VERTICAL) return segmentsCross(b1, b2, bo, a1, a2, ao);
+
+    int row = a1.x;
+    int col = b1.y;
+    return std::min(b1.x, b2.x) < row && row < std::max(b1.x, b2.x) &&
+           std::min(a1.y, a2.y) < col && col < std::max(a1.y, a2.y);
+}
+
+// Calls emit(i, j) for every pair of connections i < j that would cross
+template <typename Islands, typename Connections, typename Emit>
+constexpr void forEachCrossing(const Islands& islands, const Connections& connections, Emit&& emit) {
+    for (std::size_t i = 0; i < connections.size(); i++) {
+        const Connection& a = connections[i];
+        const Island& a1 = islands[islandIndexOf(islands, a.islandA)];
+        const Island& a2 = islands[islandIndexOf(islands, a.islandB)];
+        for (std::size_t j = i + 1; j < connections.size(); j++) {
+            const Connection& b = connections[j];
+            if (a.orientation == b.orientation) continue;
+            const Island& b1 = islands[islandIndexOf(islands, b.islandA)];
+            const Island& b2 = islands[islandIndexOf(islands, b.islandB)];
+            if (segmentsCross(a1, a2, a.orientation, b1, b2, b.orientation))
+                emit(static_cast<int>(i), static_cast<int>(j));
+        }
+    }
+}
+
 std::vector<Connection> computeConnections(
     const std::vector<Island>& islands
 );
+
+// Island coordinates stay within +-MAX_COORDINATE, which keeps board extents
+// and tile counts (see SpatialIndex) small enough to compute with plain ints
+const int MAX_COORDINATE = 4096;
+// Largest level accepted from outside the program
+const std::size_t MAX_LEVEL_ISLANDS = 65536;
+
+// Whether an island list is one the engine can build a graph for: at most
+// MAX_LEVEL_ISLANDS islands, unique ids and cells, coordinates in range and
+// degrees 1..8. O(N log N); run it before computeConnections on anything
+// read from outside the program.
+bool isValidIslandList(const std::vector<Island>& islands);
+
+// Whether islands and connections make a level the engine can hold: a valid
+// island list, and every connection a straight, unblocked span between two
+// different islands, at most one per side of an island. Anything read from
+// outside the program must pass this before computeGraphIndex.
+bool isValidLevelGraph(
+    const std::vector<Island>& islands,
+    const std::vector<Connection>& connections
+);
+
+// Throws std::out_of_range or std::invalid_argument on input that
+// isValidLevelGraph rejects
+GraphIndex computeGraphIndex(
+    const std::vector<Island>& islands,
+    const std::vector<Connection>& connections
+);
+
+// Replaces the level in `state`: islands, fresh connections and their index
+void loadLevel(GameState& state, std::vector<Island> islands);
@@ -1,32 +1,30 @@
 #include "Moves.h"
 #include "GameUtils.h"
+#include "Profiler.h"
+#include "SolveTracker.h"
 
 bool tryToggleBridge(GameState& state, int connectionIndex) {
-    if (connectionIndex < 0 || connectionIndex >= static_cast<int>(state.connections.size())) {
+    HASHI_PROFILE_SCOPE(ProfilePoint::TryToggleBridge);
+    if (!isLegalToggle(state, connectionIndex)) {
         return false;
     }
 
-    Connection& conn = state.connections[connectionIndex];
-    int originalBridges = conn.bridges;
-    
     // Cycle through bridge states: 0 -> 1 -> 2 -> 0
-    conn.bridges = (conn.bridges + 1) % 3;
-
-    // Validate that this doesn't exceed any island's required degree
-    const Island* islandA = findIsland(state, conn.islandA);
-    const Island* islandB = findIsland(state, conn.islandB);
+    setBridges(state, connectionIndex, (state.connections[connectionIndex].bridges + 1) % 3);
+    return true;
+}
 
-    if (!islandA || !islandB) {
-        conn.bridges = originalBridges;  // Revert
+bool isLegalToggle(const GameState& state, int connectionIndex) {
+    if (connectionIndex < 0 || connectionIndex >= static_cast<int>(state.connections.size())) {
         return false;
     }
 
-    // Check if either island would exceed its required degree
-    if (currentDegree(state, conn.islandA) > islandA->requiredDegree ||
-        currentDegree(state, conn.islandB) > islandB->requiredDegree) {
-        conn.bridges = originalBridges;  // Revert
-        return false;
-    }
+    // 2 -> 0 only removes bridges; adding one must respect degree limits and
+    // crossings, which the legal-move bitset already accounts for
+    return state.connections[connectionIndex].bridges == 2 || canAddBridge(state, connectionIndex);
+}
 
-    return true;
-}
\ No newline at end of file
+void undoMove(GameState& state, const MoveRecord& move) {
+    // Restoring an earlier bridge count always yields a previously legal state
+    setBridges(state, move.connectionIndex, move.previousBridges);
+}
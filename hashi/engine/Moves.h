@@ -1,4 +1,13 @@
 #pragma once
 #include "../model/GameState.h"
 
+// A single applied toggle, enough to put the connection back
+struct MoveRecord {
+    int connectionIndex;
+    int previousBridges;
+};
+
 bool tryToggleBridge(GameState& state, int connectionIndex);
+// Whether tryToggleBridge would accept this move; O(1), changes nothing
+bool isLegalToggle(const GameState& state, int connectionIndex);
+void undoMove(GameState& state, const MoveRecord& move);
@@ -0,0 +1,128 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Written only by its owning thread; read by collectProfile() from any thread
+struct ThreadCounters {
+    std::atomic<uint64_t> calls[PROFILE_POINTS];
+    std::atomic<uint64_t> totalNs[PROFILE_POINTS];
+    std::atomic<uint64_t> maxNs[PROFILE_POINTS];
+    std::atomic<uint64_t> histogram[PROFILE_POINTS][PROFILE_BUCKETS];
+
+    ThreadCounters();
+    ~ThreadCounters();
+};
+
+// Registration happens once per thread, never on the hot path
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::vector<ThreadCounters*>& liveThreads() {
+    static std::vector<ThreadCounters*> threads;
+    return threads;
+}
+
+// Totals from threads that have already exited
+ProfileReport& retiredTotals() {
+    static ProfileReport totals;
+    return totals;
+}
+
+void addInto(ProfileReport& report, const ThreadCounters& counters) {
+    for (int p = 0; p < PROFILE_POINTS; p++) {
+        ProfileStats& stats = report[p];
+        stats.calls += counters.calls[p].load(std::memory_order_relaxed);
+        stats.totalNs += counters.totalNs[p].load(std::memory_order_relaxed);
+        stats.maxNs = std::max(stats.maxNs, counters.maxNs[p].load(std::memory_order_relaxed));
+        for (int b = 0; b < PROFILE_BUCKETS; b++)
+            stats.histogram[b] += counters.histogram[p][b].load(std::memory_order_relaxed);
+    }
+}
+
+ThreadCounters::ThreadCounters() {
+    for (int p = 0; p < PROFILE_POINTS; p++) {
+        calls[p].store(0, std::memory_order_relaxed);
+        totalNs[p].store(0, std::memory_order_relaxed);
+        maxNs[p].store(0, std::memory_order_relaxed);
+        for (int b = 0; b < PROFILE_BUCKETS; b++)
+            histogram[p][b].store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(registryMutex());
+    liveThreads().push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    addInto(retiredTotals(), *this);
+    auto& threads = liveThreads();
+    threads.erase(std::remove(threads.begin(), threads.end(), this), threads.end());
+}
+
+// Single writer, so a relaxed load/store pair is enough (no locked RMW)
+void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+int bucketFor(uint64_t nanoseconds) {
+    int bucket = 0;
+    while (nanoseconds > 1 && bucket < PROFILE_BUCKETS - 1) {
+        nanoseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+const char* profilePointName(ProfilePoint point) {
+    switch (point) {
+        case ProfilePoint::ComputeConnections: return "computeConnections";
+        case ProfilePoint::TryToggleBridge: return "tryToggleBridge";
+        case ProfilePoint::CurrentDegree: return "currentDegree";
+        case ProfilePoint::IsReachable: return "isReachable";
+        case ProfilePoint::IsSolved: return "isSolved";
+        case ProfilePoint::RenderMap: return "renderMap";
+        default: return "unknown";
+    }
+}
+
+void recordProfileSample(ProfilePoint point, uint64_t nanoseconds) {
+    thread_local ThreadCounters counters;
+    int p = static_cast<int>(point);
+    bump(counters.calls[p], 1);
+    bump(counters.totalNs[p], nanoseconds);
+    if (nanoseconds > counters.maxNs[p].load(std::memory_order_relaxed))
+        counters.maxNs[p].store(nanoseconds, std::memory_order_relaxed);
+    bump(counters.histogram[p][bucketFor(nanoseconds)], 1);
+}
+
+ProfileReport collectProfile() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    ProfileReport report = retiredTotals();
+    for (const ThreadCounters* counters : liveThreads())
+        addInto(report, *counters);
+    return report;
+}
+
+void writeProfileJson(const ProfileReport& report, std::ostream& out) {
+    out << "{\n  \"enabled\": " << (PROFILING_ENABLED ? "true" : "false") << ",\n";
+    out << "  \"bucketUnit\": \"log2 ns\",\n  \"points\": {";
+    for (int p = 0; p < PROFILE_POINTS; p++) {
+        const ProfileStats& stats = report[p];
+        out << (p ? "," : "") << "\n    \"" << profilePointName(static_cast<ProfilePoint>(p)) << "\": {"
+            << "\"calls\": " << stats.calls
+            << ", \"totalNs\": " << stats.totalNs
+            << ", \"maxNs\": " << stats.maxNs
+            << ", \"histogram\": [";
+        for (int b = 0; b < PROFILE_BUCKETS; b++)
+            out << (b ? ", " : "") << stats.histogram[b];
+        out << "]}";
+    }
+    out << "\n  }\n}\n";
+}
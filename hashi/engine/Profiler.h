@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Hot-path call counters and latency histograms. Compiled in only when
+// HASHI_PROFILE is defined (`make profile`); otherwise HASHI_PROFILE_SCOPE
+// expands to nothing and the engine carries no overhead.
+//
+// Each thread records into its own block with relaxed atomic stores, so the
+// hot path never takes a lock; collectProfile() sums the blocks on demand.
+
+enum class ProfilePoint {
+    ComputeConnections,
+    TryToggleBridge,
+    CurrentDegree,
+    IsReachable,
+    IsSolved,
+    RenderMap,
+    Count
+};
+
+const int PROFILE_POINTS = static_cast<int>(ProfilePoint::Count);
+// Bucket b holds calls that took [2^b, 2^(b+1)) nanoseconds
+const int PROFILE_BUCKETS = 32;
+
+#ifdef HASHI_PROFILE
+const bool PROFILING_ENABLED = true;
+#else
+const bool PROFILING_ENABLED = false;
+#endif
+
+struct ProfileStats {
+    uint64_t calls = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    std::array<uint64_t, PROFILE_BUCKETS> histogram{};
+};
+
+using ProfileReport = std::array<ProfileStats, PROFILE_POINTS>;
+
+const char* profilePointName(ProfilePoint point);
+void recordProfileSample(ProfilePoint point, uint64_t nanoseconds);
+ProfileReport collectProfile();
+void writeProfileJson(const ProfileReport& report, std::ostream& out);
+
+class ProfileTimer {
+public:
+    explicit ProfileTimer(ProfilePoint point)
+        : point_(point), start_(std::chrono::steady_clock::now()) {}
+    ~ProfileTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        recordProfileSample(point_, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    ProfileTimer(const ProfileTimer&) = delete;
+    ProfileTimer& operator=(const ProfileTimer&) = delete;
+
+private:
+    ProfilePoint point_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#ifdef HASHI_PROFILE
+#define HASHI_PROFILE_CONCAT_(a, b) a##b
+#define HASHI_PROFILE_CONCAT(a, b) HASHI_PROFILE_CONCAT_(a, b)
+#define HASHI_PROFILE_SCOPE(point) \
+    ProfileTimer HASHI_PROFILE_CONCAT(profileTimer_, __LINE__)(point)
+#else
+#define HASHI_PROFILE_SCOPE(point) ((void)0)
+#endif
@@ -0,0 +1,139 @@
+#include "SatEncoding.h"
+#include "Cdcl.h"
+#include "SolveTracker.h"
+#include <numeric>
+
+namespace {
+
+// Exactly `k` of `lits` true, as clauses over subsets: any k + 1 of them
+// contain a false one, and any n - k + 1 of them contain a true one
+void addExactly(CdclSolver& sat, const std::vector<int>& lits, int k) {
+    int n = static_cast<int>(lits.size());
+    if (k > n || k < 0) {
+        sat.addClause({});
+        return;
+    }
+    std::vector<int> clause;
+    for (unsigned mask = 1; mask < (1u << n); mask++) {
+        int size = __builtin_popcount(mask);
+        bool atMost = size == k + 1;
+        bool atLeast = size == n - k + 1;
+        if (!atMost && !atLeast) continue;
+
+        clause.clear();
+        for (int i = 0; i < n; i++) {
+            if (mask & (1u << i)) clause.push_back(lits[i]);
+        }
+        if (atMost) {
+            std::vector<int> negated;
+            for (int lit : clause) negated.push_back(-lit);
+            sat.addClause(negated);
+        }
+        if (atLeast) sat.addClause(clause);
+    }
+}
+
+int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+} // namespace
+
+bool solveWithSat(GameState& state, SatStats* stats) {
+    const std::size_t connectionCount = state.connections.size();
+    const std::size_t islandCount = state.islands.size();
+    CdclSolver sat;
+
+    // Variables 2c+1 and 2c+2: connection c has at least one / two bridges
+    for (std::size_t c = 0; c < connectionCount; c++) {
+        int one = sat.addVariable();
+        int two = sat.addVariable();
+        sat.addClause({-two, one});
+        if (state.connections[c].bridges >= 1) sat.addClause({one});
+        if (state.connections[c].bridges == 2) sat.addClause({two});
+    }
+    auto atLeastOne = [](int c) { return 2 * c + 1; };
+    auto both = [](int c) { return 2 * c + 2; };
+
+    std::vector<int> lits;
+    for (std::size_t i = 0; i < islandCount; i++) {
+        const IslandLinks& links = state.index->links[i];
+        lits.clear();
+        for (int k = 0; k < links.count; k++) {
+            lits.push_back(atLeastOne(links.connections[k]));
+            lits.push_back(both(links.connections[k]));
+        }
+        addExactly(sat, lits, state.islands[i].requiredDegree);
+    }
+
+    for (std::size_t c = 0; c < connectionCount; c++) {
+        for (int k = state.index->conflictStart[c]; k < state.index->conflictStart[c + 1]; k++) {
+            int other = state.index->conflictList[k];
+            if (other > static_cast<int>(c))
+                sat.addClause({-atLeastOne(static_cast<int>(c)), -atLeastOne(other)});
+        }
+    }
+
+    std::vector<int> bridges(connectionCount);
+    std::vector<int> parent(islandCount);
+    bool solved = false;
+    int rounds = 0;
+    while (true) {
+        rounds++;
+        if (sat.solve() != CdclSolver::Result::Satisfiable) break;
+
+        for (std::size_t c = 0; c < connectionCount; c++) {
+            int c1 = static_cast<int>(c);
+            bridges[c] = sat.modelValue(atLeastOne(c1)) + sat.modelValue(both(c1));
+        }
+
+        std::iota(parent.begin(), parent.end(), 0);
+        int components = static_cast<int>(islandCount);
+        for (std::size_t c = 0; c < connectionCount; c++) {
+            if (bridges[c] == 0) continue;
+            int a = findRoot(parent, state.index->ends[c].a);
+            int b = findRoot(parent, state.index->ends[c].b);
+            if (a != b) {
+                parent[b] = a;
+                components--;
+            }
+        }
+        if (components <= 1) {
+            solved = true;
+            break;
+        }
+
+        // One cut per component: a bridge must leave it somewhere
+        std::vector<std::vector<int>> cuts(islandCount);
+        for (std::size_t c = 0; c < connectionCount; c++) {
+            int a = findRoot(parent, state.index->ends[c].a);
+            int b = findRoot(parent, state.index->ends[c].b);
+            if (a == b) continue;
+            cuts[a].push_back(atLeastOne(static_cast<int>(c)));
+            cuts[b].push_back(atLeastOne(static_cast<int>(c)));
+        }
+        bool consistent = true;
+        for (std::size_t i = 0; i < islandCount && consistent; i++) {
+            if (findRoot(parent, static_cast<int>(i)) == static_cast<int>(i))
+                consistent = sat.addClause(cuts[i]);
+        }
+        if (!consistent) break;
+    }
+
+    if (stats) {
+        stats->variables = sat.variables();
+        stats->clauses = sat.clauses();
+        stats->rounds = rounds;
+        stats->conflicts = sat.conflicts();
+        stats->decisions = sat.decisions();
+    }
+    if (!solved) return false;
+
+    for (std::size_t c = 0; c < connectionCount; c++)
+        setBridges(state, static_cast<int>(c), bridges[c]);
+    return true;
+}
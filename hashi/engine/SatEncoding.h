@@ -0,0 +1,28 @@
+#pragma once
+#include "../model/GameState.h"
+
+struct SatStats {
+    int variables = 0;
+    int clauses = 0;      // problem and learnt clauses at the end
+    int rounds = 0;       // solve calls; each one after the first added connectivity cuts
+    long conflicts = 0;
+    long decisions = 0;
+};
+
+// Alternative to the search Solver for very large boards. Encodes the
+// position as CNF and hands it to the embedded CdclSolver:
+//
+//   per connection   x1 "at least one bridge", x2 "two bridges", x2 -> x1,
+//                    plus units for bridges already on the board
+//   per island       sum of x1 + x2 over its connections == required degree
+//                    (at most four connections, so the cardinality
+//                    constraint is spelled out as subset clauses)
+//   per crossing     not both x1
+//
+// Connectivity is left out of the encoding. Each model that splits into
+// several components gets one cut clause per component ("some connection
+// leaving this group has a bridge") and the formula is solved again.
+//
+// On success the bridges are written through setBridges and true is
+// returned; otherwise `state` is left as it was.
+bool solveWithSat(GameState& state, SatStats* stats = nullptr);
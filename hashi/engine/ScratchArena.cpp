@@ -0,0 +1,43 @@
+#include "ScratchArena.h"
+
+namespace {
+const std::size_t FIRST_BLOCK_BYTES = 16 * 1024;
+}
+
+ScratchArena& ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+std::size_t ScratchArena::capacity() const {
+    std::size_t total = 0;
+    for (const auto& block : blocks_) total += block.size;
+    return total;
+}
+
+void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    while (true) {
+        // Try the current block, then any later blocks kept from earlier queries
+        if (current_ < blocks_.size()) {
+            Block& block = blocks_[current_];
+            void* p = block.data.get() + offset_;
+            std::size_t space = block.size - offset_;
+            if (std::align(alignment, bytes, p, space)) {
+                offset_ = static_cast<std::size_t>(static_cast<std::byte*>(p) - block.data.get()) + bytes;
+                return p;
+            }
+            if (current_ + 1 < blocks_.size()) {
+                current_++;
+                offset_ = 0;
+                continue;
+            }
+        }
+
+        // Grow geometrically; new blocks are kept for reuse after a rewind
+        std::size_t size = blocks_.empty() ? FIRST_BLOCK_BYTES : blocks_.back().size * 2;
+        while (size < bytes + alignment) size *= 2;
+        blocks_.push_back({std::make_unique<std::byte[]>(size), size});
+        current_ = blocks_.size() - 1;
+        offset_ = 0;
+    }
+}
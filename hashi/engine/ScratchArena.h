@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Per-thread bump allocator for engine scratch data (BFS queues, visited
+// sets, search stacks, worklists). Memory is never returned piecemeal;
+// a ScratchScope rewinds everything allocated inside it in O(1), and the
+// underlying blocks are kept, so once warmed up queries allocate nothing
+// from the heap.
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    static ScratchArena& local();
+
+    Mark mark() const { return {current_, offset_}; }
+    void rewind(Mark m) { current_ = m.block; offset_ = m.offset; }
+    std::size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;
+    std::size_t offset_ = 0;
+};
+
+// Scratch allocations made while a scope is alive are released when it ends.
+// Scopes nest, so helpers can open their own inside a caller's scope.
+class ScratchScope {
+public:
+    ScratchScope() : arena_(ScratchArena::local()), mark_(arena_.mark()) {}
+    ~ScratchScope() { arena_.rewind(mark_); }
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    std::pmr::memory_resource* resource() { return &arena_; }
+
+private:
+    ScratchArena& arena_;
+    ScratchArena::Mark mark_;
+};
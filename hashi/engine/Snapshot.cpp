@@ -0,0 +1,244 @@
+#include "Snapshot.h"
+#include "GraphBuilder.h"
+#include "SolveTracker.h"
+#include "SpatialIndex.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char LEVEL_MAGIC[4] = {'H', 'L', 'V', 'L'};
+const char SNAPSHOT_MAGIC[4] = {'H', 'S', 'N', 'P'};
+const size_t SNAPSHOT_HEADER_SIZE = 4 + 1 + 8 + 4;
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+// Bounds-checked little-endian reader
+struct Reader {
+    const std::vector<uint8_t>& data;
+    size_t pos;
+
+    bool has(size_t n) const { return data.size() - pos >= n; }
+
+    bool magic(const char (&expected)[4]) {
+        if (!has(4) || std::memcmp(&data[pos], expected, 4) != 0) return false;
+        pos += 4;
+        return true;
+    }
+
+    bool u8(uint8_t& v) {
+        if (!has(1)) return false;
+        v = data[pos++];
+        return true;
+    }
+
+    bool u32(uint32_t& v) {
+        if (!has(4)) return false;
+        v = 0;
+        for (int i = 0; i < 4; i++) v |= static_cast<uint32_t>(data[pos++]) << (8 * i);
+        return true;
+    }
+
+    bool i32(int& v) {
+        uint32_t raw;
+        if (!u32(raw)) return false;
+        v = static_cast<int>(raw);
+        return true;
+    }
+
+    bool u64(uint64_t& v) {
+        if (!has(8)) return false;
+        v = 0;
+        for (int i = 0; i < 8; i++) v |= static_cast<uint64_t>(data[pos++]) << (8 * i);
+        return true;
+    }
+};
+
+// FNV-1a step over a whole 32-bit word rather than byte by byte
+void hashInt(uint64_t& h, int value) {
+    h ^= static_cast<uint32_t>(value);
+    h *= 1099511628211ULL;
+}
+
+} // namespace
+
+uint64_t levelHash(const std::vector<Island>& islands, const std::vector<Connection>& connections) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const auto& island : islands) {
+        hashInt(h, island.id);
+        hashInt(h, island.x);
+        hashInt(h, island.y);
+        hashInt(h, island.requiredDegree);
+    }
+    // Bridge counts are stored by connection position, so the order matters
+    for (const auto& conn : connections) {
+        hashInt(h, conn.islandA);
+        hashInt(h, conn.islandB);
+        hashInt(h, conn.orientation == Orientation::HORIZONTAL ? 0 : 1);
+    }
+    return h;
+}
+
+std::vector<uint8_t> saveLevelRecord(const GameState& state) {
+    std::vector<uint8_t> out;
+    out.reserve(4 + 1 + 8 + 8 + state.islands.size() * 16 + state.connections.size() * 9);
+    out.insert(out.end(), LEVEL_MAGIC, LEVEL_MAGIC + 4);
+    out.push_back(SNAPSHOT_VERSION);
+    putU64(out, levelHash(state.islands, state.connections));
+
+    putU32(out, static_cast<uint32_t>(state.islands.size()));
+    for (const auto& island : state.islands) {
+        putU32(out, static_cast<uint32_t>(island.id));
+        putU32(out, static_cast<uint32_t>(island.x));
+        putU32(out, static_cast<uint32_t>(island.y));
+        putU32(out, static_cast<uint32_t>(island.requiredDegree));
+    }
+
+    putU32(out, static_cast<uint32_t>(state.connections.size()));
+    for (const auto& conn : state.connections) {
+        putU32(out, static_cast<uint32_t>(conn.islandA));
+        putU32(out, static_cast<uint32_t>(conn.islandB));
+        out.push_back(conn.orientation == Orientation::HORIZONTAL ? 0 : 1);
+    }
+    return out;
+}
+
+bool readLevelRecord(const std::vector<uint8_t>& data, std::vector<Island>& islandsOut,
+                     std::vector<Connection>& connectionsOut) {
+    Reader in{data, 0};
+    uint8_t version;
+    uint64_t hash;
+    uint32_t islandCount;
+    if (!in.magic(LEVEL_MAGIC) || !in.u8(version) || version != SNAPSHOT_VERSION ||
+        !in.u64(hash) || !in.u32(islandCount) || islandCount > MAX_LEVEL_ISLANDS ||
+        !in.has(static_cast<size_t>(islandCount) * 16)) {
+        return false;
+    }
+
+    std::vector<Island> islands(islandCount);
+    for (auto& island : islands) {
+        in.i32(island.id);
+        in.i32(island.x);
+        in.i32(island.y);
+        in.i32(island.requiredDegree);
+    }
+
+    uint32_t connectionCount;
+    // At most one connection per side of an island, each shared by two
+    if (!in.u32(connectionCount) || connectionCount > 2 * static_cast<size_t>(islandCount) ||
+        !in.has(static_cast<size_t>(connectionCount) * 9)) {
+        return false;
+    }
+
+    std::vector<Connection> connections(connectionCount);
+    for (auto& conn : connections) {
+        uint8_t orientation = 0;
+        in.i32(conn.islandA);
+        in.i32(conn.islandB);
+        in.u8(orientation);
+        if (orientation > 1) return false;
+        conn.orientation = orientation == 0 ? Orientation::HORIZONTAL : Orientation::VERTICAL;
+        conn.bridges = 0;
+    }
+    if (levelHash(islands, connections) != hash) return false;
+    // Framing alone says nothing about the graph; the index builder and
+    // everything after it rely on a well-formed level
+    if (!isValidLevelGraph(islands, connections)) return false;
+
+    islandsOut = std::move(islands);
+    connectionsOut = std::move(connections);
+    return true;
+}
+
+bool loadLevelRecord(GameState& state, const std::vector<uint8_t>& data) {
+    std::vector<Island> islands;
+    std::vector<Connection> connections;
+    if (!readLevelRecord(data, islands, connections)) return false;
+
+    state.islands = std::move(islands);
+    state.connections = std::move(connections);
+    state.index = std::make_shared<const GraphIndex>(computeGraphIndex(state.islands, state.connections));
+    buildSpatialIndex(state);
+    rebuildProgress(state);
+    return true;
+}
+
+std::vector<uint8_t> saveSnapshot(const GameState& state) {
+    size_t count = state.connections.size();
+    std::vector<uint8_t> out;
+    out.reserve(SNAPSHOT_HEADER_SIZE + (count + 3) / 4);
+    out.insert(out.end(), SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 4);
+    out.push_back(SNAPSHOT_VERSION);
+    putU64(out, levelHash(state.islands, state.connections));
+    putU32(out, static_cast<uint32_t>(count));
+
+    // Four 2-bit bridge counts per byte, first connection in the low bits
+    for (size_t i = 0; i < count; i += 4) {
+        uint8_t packed = 0;
+        for (size_t j = 0; j < 4 && i + j < count; j++) {
+            packed |= static_cast<uint8_t>((state.connections[i + j].bridges & 0x3) << (2 * j));
+        }
+        out.push_back(packed);
+    }
+    return out;
+}
+
+bool restoreSnapshot(GameState& state, const std::vector<uint8_t>& data) {
+    Reader in{data, 0};
+    uint8_t version;
+    uint64_t hash;
+    uint32_t count;
+    if (!in.magic(SNAPSHOT_MAGIC) || !in.u8(version) || version != SNAPSHOT_VERSION ||
+        !in.u64(hash) || !in.u32(count)) {
+        return false;
+    }
+    if (count != state.connections.size() || !in.has((count + 3) / 4)) return false;
+    if (hash != levelHash(state.islands, state.connections)) return false;
+
+    // Validate every field before touching the state: counts in range, no
+    // island over its degree and no crossing bridges, so moves and the
+    // solved summary can rely on a legal board
+    const uint8_t* packed = data.data() + in.pos;
+    auto bridgesAt = [packed](uint32_t i) { return (packed[i / 4] >> (2 * (i % 4))) & 0x3; };
+    std::vector<int> degree(state.islands.size(), 0);
+    for (uint32_t i = 0; i < count; i++) {
+        int bridges = bridgesAt(i);
+        if (bridges == 3) return false;
+        degree[state.index->ends[i].a] += bridges;
+        degree[state.index->ends[i].b] += bridges;
+        if (bridges == 0) continue;
+        for (int k = state.index->conflictStart[i]; k < state.index->conflictStart[i + 1]; k++) {
+            if (bridgesAt(state.index->conflictList[k]) > 0) return false;
+        }
+    }
+    for (size_t i = 0; i < state.islands.size(); i++) {
+        if (degree[i] > state.islands[i].requiredDegree) return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        state.connections[i].bridges = bridgesAt(i);
+    }
+    rebuildProgress(state);
+    return true;
+}
+
+bool writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool readBinaryFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "../model/GameState.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary save format, split in two so that the (large, shared) level data is
+// stored once per level and every session snapshot only carries bridge counts.
+//
+// Level record:   "HLVL" | version | hash | islands | connection topology
+// Snapshot:       "HSNP" | version | level hash | connection count |
+//                 bridge counts packed 2 bits each, 4 per byte
+//
+// All integers are little-endian.
+
+// Version 2: the level hash covers connection topology as well as islands
+const uint8_t SNAPSHOT_VERSION = 2;
+
+// FNV-1a (word-wise) over the island list and each connection's ends and
+// orientation; identifies which level, in which connection order, a
+// snapshot's bridge counts belong to
+uint64_t levelHash(const std::vector<Island>& islands, const std::vector<Connection>& connections);
+
+std::vector<uint8_t> saveLevelRecord(const GameState& state);
+// Decodes just the islands and connections of a level record. Rejects
+// records whose graph fails isValidLevelGraph, so the result is always safe
+// to pass to computeGraphIndex.
+bool readLevelRecord(const std::vector<uint8_t>& data, std::vector<Island>& islands,
+                     std::vector<Connection>& connections);
+// Rebuilds islands, connections (all bridges 0) and their index without
+// rerunning computeConnections
+bool loadLevelRecord(GameState& state, const std::vector<uint8_t>& data);
+
+std::vector<uint8_t> saveSnapshot(const GameState& state);
+// `state` must already hold the snapshot's level; only bridge counts change.
+// Leaves `state` untouched and returns false on any mismatch.
+bool restoreSnapshot(GameState& state, const std::vector<uint8_t>& data);
+
+bool writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data);
+bool readBinaryFile(const std::string& path, std::vector<uint8_t>& data);
@@ -0,0 +1,275 @@
+#include "SolveTracker.h"
+#include "ScratchArena.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+
+int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];  // path halving
+        i = parent[i];
+    }
+    return i;
+}
+
+void joinIslands(SolveProgress& progress, int a, int b) {
+    int ra = findRoot(progress.parent, a);
+    int rb = findRoot(progress.parent, b);
+    if (ra == rb) return;
+    progress.parent[rb] = ra;
+    progress.components--;
+}
+
+void rebuildComponents(GameState& state) {
+    SolveProgress& progress = state.progress;
+    progress.parent.resize(state.islands.size());
+    for (std::size_t i = 0; i < progress.parent.size(); i++)
+        progress.parent[i] = static_cast<int>(i);
+    progress.components = static_cast<int>(state.islands.size());
+
+    for (std::size_t c = 0; c < state.connections.size(); c++) {
+        if (state.connections[c].bridges > 0)
+            joinIslands(progress, state.index->ends[c].a, state.index->ends[c].b);
+    }
+    progress.componentsStale = false;
+}
+
+// Adjusts one island's degree and the satisfied count
+void addDegree(GameState& state, int island, int delta) {
+    SolveProgress& progress = state.progress;
+    int required = state.islands[island].requiredDegree;
+    if (progress.degree[island] == required) progress.satisfiedIslands--;
+    progress.degree[island] += delta;
+    if (progress.degree[island] == required) progress.satisfiedIslands++;
+}
+
+void refreshLegal(GameState& state, int c) {
+    const ConnectionEnds& ends = state.index->ends[c];
+    const std::vector<int>& degree = state.progress.degree;
+    bool addable = state.connections[c].bridges < 2 &&
+                   degree[ends.a] < state.islands[ends.a].requiredDegree &&
+                   degree[ends.b] < state.islands[ends.b].requiredDegree &&
+                   (state.connections[c].bridges > 0 || state.legal.crossBlockers[c] == 0);
+
+    uint64_t bit = uint64_t(1) << (c & 63);
+    uint64_t& word = state.legal.addable[c >> 6];
+    word = addable ? (word | bit) : (word & ~bit);
+}
+
+void refreshIslandLinks(GameState& state, int island) {
+    const IslandLinks& links = state.index->links[island];
+    for (int k = 0; k < links.count; k++)
+        refreshLegal(state, links.connections[k]);
+}
+
+int remainingNeed(const GameState& state, int island) {
+    return state.islands[island].requiredDegree - state.progress.degree[island];
+}
+
+// Bridges that could still be added on connection c, ignoring everything else
+int spareCapacity(const GameState& state, int c) {
+    int bridges = state.connections[c].bridges;
+    if (bridges == 2 || (bridges == 0 && state.legal.crossBlockers[c] > 0)) return 0;
+    const ConnectionEnds& ends = state.index->ends[c];
+    return std::min(2 - bridges, std::min(remainingNeed(state, ends.a), remainingNeed(state, ends.b)));
+}
+
+void refreshCapacity(GameState& state, int island) {
+    int need = remainingNeed(state, island);
+    int available = 0;
+    const IslandLinks& links = state.index->links[island];
+    for (int k = 0; k < links.count && available < need; k++)
+        available += spareCapacity(state, links.connections[k]);
+
+    SolveProgress& progress = state.progress;
+    char shortNow = need > available;
+    progress.shortIslands += shortNow - progress.shortOfCapacity[island];
+    progress.shortOfCapacity[island] = shortNow;
+}
+
+// Re-checks an island and every island it could still bridge to
+void refreshCapacityAround(GameState& state, int island) {
+    refreshCapacity(state, island);
+    const IslandLinks& links = state.index->links[island];
+    for (int k = 0; k < links.count; k++) {
+        const ConnectionEnds& ends = state.index->ends[links.connections[k]];
+        refreshCapacity(state, ends.a == island ? ends.b : ends.a);
+    }
+}
+
+// Walks the bridged component of `start`, calling visit(island) on each.
+// Stops early and returns false if visit returns false.
+template <typename Visit>
+bool walkComponent(GameState& state, int start, Visit&& visit) {
+    SolveProgress& progress = state.progress;
+    unsigned mark = ++progress.stamp;
+    ScratchScope scope;
+    std::pmr::vector<int> queue(scope.resource());
+    queue.push_back(start);
+    progress.visitStamp[start] = mark;
+
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        int curr = queue[head];
+        if (!visit(curr)) return false;
+        const IslandLinks& links = state.index->links[curr];
+        for (int k = 0; k < links.count; k++) {
+            int c = links.connections[k];
+            if (state.connections[c].bridges == 0) continue;
+            const ConnectionEnds& ends = state.index->ends[c];
+            int next = (ends.a == curr) ? ends.b : ends.a;
+            if (progress.visitStamp[next] == mark) continue;
+            progress.visitStamp[next] = mark;
+            queue.push_back(next);
+        }
+    }
+    return true;
+}
+
+void clearClosed(GameState& state, int start) {
+    SolveProgress& progress = state.progress;
+    walkComponent(state, start, [&](int island) {
+        if (progress.closedOff[island]) {
+            progress.closedOff[island] = 0;
+            progress.closedIslands--;
+        }
+        return true;
+    });
+}
+
+// Flags the component of `start` if it is saturated yet misses some island
+void checkClosed(GameState& state, int start) {
+    int size = 0;
+    bool saturated = walkComponent(state, start, [&](int island) {
+        size++;
+        return remainingNeed(state, island) == 0;
+    });
+    if (!saturated || size == static_cast<int>(state.islands.size())) return;
+
+    SolveProgress& progress = state.progress;
+    walkComponent(state, start, [&](int island) {
+        if (!progress.closedOff[island]) {
+            progress.closedOff[island] = 1;
+            progress.closedIslands++;
+        }
+        return true;
+    });
+}
+
+} // namespace
+
+void rebuildProgress(GameState& state) {
+    SolveProgress& progress = state.progress;
+    progress.degree.assign(state.islands.size(), 0);
+    for (std::size_t c = 0; c < state.connections.size(); c++) {
+        progress.degree[state.index->ends[c].a] += state.connections[c].bridges;
+        progress.degree[state.index->ends[c].b] += state.connections[c].bridges;
+    }
+
+    progress.satisfiedIslands = 0;
+    for (std::size_t i = 0; i < state.islands.size(); i++) {
+        if (progress.degree[i] == state.islands[i].requiredDegree)
+            progress.satisfiedIslands++;
+    }
+    rebuildComponents(state);
+
+    LegalMoves& legal = state.legal;
+    legal.crossBlockers.assign(state.connections.size(), 0);
+    for (std::size_t c = 0; c < state.connections.size(); c++) {
+        if (state.connections[c].bridges == 0) continue;
+        for (int k = state.index->conflictStart[c]; k < state.index->conflictStart[c + 1]; k++)
+            legal.crossBlockers[state.index->conflictList[k]]++;
+    }
+    legal.addable.assign((state.connections.size() + 63) / 64, 0);
+    for (std::size_t c = 0; c < state.connections.size(); c++)
+        refreshLegal(state, static_cast<int>(c));
+
+    progress.shortOfCapacity.assign(state.islands.size(), 0);
+    progress.shortIslands = 0;
+    progress.closedOff.assign(state.islands.size(), 0);
+    progress.closedIslands = 0;
+    progress.visitStamp.assign(state.islands.size(), 0);
+    progress.stamp = 0;
+    for (std::size_t i = 0; i < state.islands.size(); i++)
+        refreshCapacity(state, static_cast<int>(i));
+
+    // Label each component once; a walk stamps every island it reaches
+    std::vector<char> seen(state.islands.size(), 0);
+    for (std::size_t i = 0; i < state.islands.size(); i++) {
+        if (seen[i]) continue;
+        int size = 0;
+        bool saturated = true;
+        walkComponent(state, static_cast<int>(i), [&](int island) {
+            seen[island] = 1;
+            size++;
+            saturated = saturated && remainingNeed(state, island) == 0;
+            return true;
+        });
+        if (saturated && size < static_cast<int>(state.islands.size()))
+            checkClosed(state, static_cast<int>(i));
+    }
+}
+
+void setBridges(GameState& state, int connectionIndex, int bridges) {
+    Connection& conn = state.connections[connectionIndex];
+    int previous = conn.bridges;
+    if (previous == bridges) return;
+    conn.bridges = bridges;
+
+    const ConnectionEnds& ends = state.index->ends[connectionIndex];
+    bool wasClosed = state.progress.closedOff[ends.a];
+    addDegree(state, ends.a, bridges - previous);
+    addDegree(state, ends.b, bridges - previous);
+
+    SolveProgress& progress = state.progress;
+    if (previous == 0) {
+        if (!progress.componentsStale) joinIslands(progress, ends.a, ends.b);
+    } else if (bridges == 0) {
+        progress.componentsStale = true;
+    }
+
+    if (progress.componentsStale &&
+        progress.satisfiedIslands == static_cast<int>(state.islands.size())) {
+        rebuildComponents(state);
+    }
+
+    // A span appearing or disappearing changes what its crossings may do
+    if (previous == 0 || bridges == 0) {
+        int step = (previous == 0) ? 1 : -1;
+        for (int k = state.index->conflictStart[connectionIndex]; k < state.index->conflictStart[connectionIndex + 1]; k++) {
+            int other = state.index->conflictList[k];
+            state.legal.crossBlockers[other] += step;
+            refreshLegal(state, other);
+            refreshCapacity(state, state.index->ends[other].a);
+            refreshCapacity(state, state.index->ends[other].b);
+        }
+    }
+
+    // Degree changes at either end affect every connection of those islands
+    refreshIslandLinks(state, ends.a);
+    refreshIslandLinks(state, ends.b);
+    refreshCapacityAround(state, ends.a);
+    refreshCapacityAround(state, ends.b);
+
+    // Closed components can only form when bridges are added, and only
+    // break up when they are taken away
+    if (bridges < previous) {
+        if (wasClosed) {
+            clearClosed(state, ends.a);
+            clearClosed(state, ends.b);
+        }
+    } else if (remainingNeed(state, ends.a) == 0 && remainingNeed(state, ends.b) == 0) {
+        checkClosed(state, ends.a);
+    }
+}
+
+bool progressDeadEnd(const GameState& state) {
+    return state.progress.shortIslands > 0 || state.progress.closedIslands > 0;
+}
+
+bool progressSolved(const GameState& state) {
+    const SolveProgress& progress = state.progress;
+    int islandCount = static_cast<int>(state.islands.size());
+    return progress.satisfiedIslands == islandCount &&
+           (islandCount == 0 || (!progress.componentsStale && progress.components == 1));
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "../model/GameState.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// All bridge counts change through setBridges so that GameState::progress
+// and GameState::legal stay in step with the board. Loaders call
+// rebuildProgress once after filling in a level.
+
+// Recomputes degrees, satisfied count, components and legal moves from
+// scratch: O(N + C)
+void rebuildProgress(GameState& state);
+
+// Sets one connection's bridge count and updates progress locally. Adding a
+// bridge merges components in near-constant time; removing one only marks
+// components stale, and they are rebuilt when every island is satisfied
+// again (the only time connectivity can decide the result). Legal-move bits
+// are refreshed only for the connections touching the two islands and the
+// connections crossing this one.
+void setBridges(GameState& state, int connectionIndex, int bridges);
+
+// O(1): every island satisfied and all islands in one component
+bool progressSolved(const GameState& state);
+
+// O(1): the position cannot be completed by adding bridges, because some
+// island needs more than its neighbours can still give, or a saturated
+// component is cut off from the remaining islands. Both detectors are
+// updated by setBridges over the islands around the changed connection
+// (and, when a component closes or opens, over that component).
+bool progressDeadEnd(const GameState& state);
+
+inline bool canAddBridge(const GameState& state, int connectionIndex) {
+    return (state.legal.addable[connectionIndex >> 6] >> (connectionIndex & 63)) & 1;
+}
+
+// Calls visit(connectionIndex) for each connection that can take another
+// bridge, scanning the bitset a word at a time
+template <typename Visit>
+void forEachAddableConnection(const GameState& state, Visit&& visit) {
+    const std::vector<uint64_t>& words = state.legal.addable;
+    for (std::size_t w = 0; w < words.size(); w++) {
+        for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1)
+            visit(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+    }
+}
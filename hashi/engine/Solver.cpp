@@ -0,0 +1,211 @@
+#include "Solver.h"
+#include "SolveTracker.h"
+#include <algorithm>
+
+Solver::Solver(GameState& state)
+    : state_(state),
+      cap_(state.connections.size(), 2),
+      queued_(state.islands.size(), 0) {
+    for (std::size_t i = 0; i < state.islands.size(); i++)
+        queue(static_cast<int>(i));
+}
+
+SolveStep Solver::step() {
+    while (!finished_) {
+        if (unwinding_) {
+            SolveStep result;
+            if (unwindOne(result)) return result;
+            continue;
+        }
+        if (progressSolved(state_)) return finish(SolveEvent::Solved);
+        if (progressDeadEnd(state_)) {
+            unwinding_ = true;
+            continue;
+        }
+
+        // Propagate: pull islands off the worklist until one forces a bridge
+        bool contradiction = false;
+        while (!worklist_.empty() && !contradiction) {
+            int island = worklist_.back();
+            worklist_.pop_back();
+            queued_[island] = 0;
+
+            int forced = -1;
+            contradiction = !examine(island, forced);
+            if (forced >= 0) {
+                apply(forced, state_.connections[forced].bridges + 1);
+                steps_++;
+                return last_ = {SolveEvent::Deduced, forced, state_.connections[forced].bridges};
+            }
+        }
+        if (contradiction) {
+            unwinding_ = true;
+            continue;
+        }
+
+        // Nothing forced: branch on one more bridge, then on none
+        int guess = chooseGuess();
+        if (guess < 0) {
+            unwinding_ = true;
+            continue;
+        }
+        decisions_.push_back({trail_.size(), guess, false});
+        apply(guess, state_.connections[guess].bridges + 1);
+        steps_++;
+        return last_ = {SolveEvent::Guessed, guess, state_.connections[guess].bridges};
+    }
+    return last_;
+}
+
+void Solver::rewind() {
+    while (!trail_.empty()) undoLast();
+    decisions_.clear();
+}
+
+std::vector<MoveRecord> Solver::appliedMoves() const {
+    std::vector<MoveRecord> moves;
+    for (const Change& change : trail_) {
+        if (change.previousBridges >= 0) moves.push_back({change.connection, change.previousBridges});
+    }
+    return moves;
+}
+
+// Bridges that could still go on `connection`, given the caps and the
+// remaining need at both ends
+int Solver::spare(int connection) const {
+    int bridges = state_.connections[connection].bridges;
+    if (!canAddBridge(state_, connection) || bridges >= cap_[connection]) return 0;
+    const ConnectionEnds& ends = state_.index->ends[connection];
+    int needA = state_.islands[ends.a].requiredDegree - state_.progress.degree[ends.a];
+    int needB = state_.islands[ends.b].requiredDegree - state_.progress.degree[ends.b];
+    return std::min(cap_[connection] - bridges, std::min(needA, needB));
+}
+
+// Returns false if `island` can no longer be satisfied. Otherwise sets
+// `forced` to a connection that must take another bridge, or leaves it
+// alone if there is none.
+bool Solver::examine(int island, int& forced) const {
+    int need = state_.islands[island].requiredDegree - state_.progress.degree[island];
+    if (need == 0) return true;
+
+    const IslandLinks& links = state_.index->links[island];
+    int total = 0;
+    for (int k = 0; k < links.count; k++) total += spare(links.connections[k]);
+    if (total < need) return false;
+
+    // Whatever the other connections cannot cover has to go on this one
+    for (int k = 0; k < links.count; k++) {
+        int c = links.connections[k];
+        int own = spare(c);
+        if (own > 0 && need - (total - own) > 0) {
+            forced = c;
+            return true;
+        }
+    }
+    return true;
+}
+
+// First open connection of the unsatisfied island with the fewest options
+int Solver::chooseGuess() const {
+    int best = -1;
+    int bestOptions = 5;
+    for (std::size_t i = 0; i < state_.islands.size(); i++) {
+        if (state_.progress.degree[i] == state_.islands[i].requiredDegree) continue;
+        const IslandLinks& links = state_.index->links[i];
+        int options = 0;
+        int first = -1;
+        for (int k = 0; k < links.count; k++) {
+            if (spare(links.connections[k]) == 0) continue;
+            if (options++ == 0) first = links.connections[k];
+        }
+        if (options > 0 && options < bestOptions) {
+            best = first;
+            bestOptions = options;
+        }
+    }
+    return best;
+}
+
+void Solver::apply(int connection, int bridges) {
+    trail_.push_back({connection, state_.connections[connection].bridges, cap_[connection]});
+    setBridges(state_, connection, bridges);
+    touch(connection);
+}
+
+void Solver::setCap(int connection, int cap) {
+    trail_.push_back({connection, -1, cap_[connection]});
+    cap_[connection] = cap;
+    touch(connection);
+}
+
+void Solver::undoLast() {
+    Change change = trail_.back();
+    trail_.pop_back();
+    cap_[change.connection] = change.previousCap;
+    if (change.previousBridges >= 0) setBridges(state_, change.connection, change.previousBridges);
+    touch(change.connection);
+}
+
+// Queues every island whose deductions depend on `connection`: its ends,
+// their neighbours, and the ends of connections it crosses
+void Solver::touch(int connection) {
+    const ConnectionEnds& ends = state_.index->ends[connection];
+    for (int end : {ends.a, ends.b}) {
+        const IslandLinks& links = state_.index->links[end];
+        for (int k = 0; k < links.count; k++) {
+            const ConnectionEnds& around = state_.index->ends[links.connections[k]];
+            queue(around.a);
+            queue(around.b);
+        }
+    }
+    const GraphIndex& index = *state_.index;
+    for (int k = index.conflictStart[connection]; k < index.conflictStart[connection + 1]; k++) {
+        queue(index.ends[index.conflictList[k]].a);
+        queue(index.ends[index.conflictList[k]].b);
+    }
+}
+
+void Solver::queue(int island) {
+    if (queued_[island]) return;
+    queued_[island] = 1;
+    worklist_.push_back(island);
+}
+
+// One step of backtracking. Returns true with `result` set when a bridge
+// came off the board; false when the caller should carry on searching.
+bool Solver::unwindOne(SolveStep& result) {
+    if (decisions_.empty()) {
+        result = finish(SolveEvent::Failed);
+        return true;
+    }
+
+    Decision& decision = decisions_.back();
+    while (trail_.size() > decision.trailSize) {
+        int connection = trail_.back().connection;
+        bool bridgeChange = trail_.back().previousBridges >= 0;
+        undoLast();
+        if (bridgeChange) {
+            steps_++;
+            result = last_ = {SolveEvent::Backtracked, connection, state_.connections[connection].bridges};
+            return true;
+        }
+    }
+
+    if (decision.exhausted) {
+        // Both branches failed; the failure belongs to the decision below
+        decisions_.pop_back();
+        return false;
+    }
+
+    // Second branch: the guessed connection keeps the bridges it had
+    decision.exhausted = true;
+    setCap(decision.connection, state_.connections[decision.connection].bridges);
+    unwinding_ = false;
+    return false;
+}
+
+SolveStep Solver::finish(SolveEvent event) {
+    finished_ = true;
+    unwinding_ = false;
+    return last_ = {event, -1, 0};
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "../model/GameState.h"
+#include "Moves.h"
+#include <vector>
+
+enum class SolveEvent {
+    Deduced,      // a bridge every solution must have from here
+    Guessed,      // a bridge tried on a branch
+    Backtracked,  // a bridge taken back after a branch failed
+    Solved,
+    Failed        // no solution from the starting position
+};
+
+// Steps an interactive solve (the server's SOLVE, the console's watch) may
+// take before its caller gives up and rewinds
+const int MAX_SOLVE_STEPS = 1000000;
+
+struct SolveStep {
+    SolveEvent event;
+    int connectionIndex;  // -1 for Solved and Failed
+    int bridges;          // count on that connection after the step
+};
+
+// Depth-first search with propagation, written as a resumable state machine
+// instead of a recursive function: every call to step() makes at most one
+// bridge change on the caller's GameState and returns. Search state lives in
+// the solver (a trail of changes and a stack of open decisions), so a caller
+// can render between steps, stop at any point, or interleave many solves on
+// one thread. Nothing is copied per step; branches are undone through the
+// trail with setBridges.
+//
+// Bridges already on the board when the solver starts are kept.
+class Solver {
+public:
+    explicit Solver(GameState& state);
+
+    SolveStep step();
+    bool finished() const { return finished_; }
+    int steps() const { return steps_; }
+
+    // Undoes every change the solver has made, leaving the starting position
+    void rewind();
+
+    // Bridge changes still on the board, oldest first; undoing them in
+    // reverse order returns to the starting position
+    std::vector<MoveRecord> appliedMoves() const;
+
+private:
+    struct Change {
+        int connection;
+        int previousBridges;  // -1 if only the cap changed
+        int previousCap;
+    };
+
+    struct Decision {
+        std::size_t trailSize;  // trail length before the guess
+        int connection;
+        bool exhausted;         // the "no more bridges here" branch is running
+    };
+
+    int spare(int connection) const;
+    bool examine(int island, int& forced) const;
+    int chooseGuess() const;
+    void apply(int connection, int bridges);
+    void setCap(int connection, int cap);
+    void undoLast();
+    void touch(int connection);
+    void queue(int island);
+    bool unwindOne(SolveStep& result);
+    SolveStep finish(SolveEvent event);
+
+    GameState& state_;
+    std::vector<int> cap_;            // most bridges each connection may still reach
+    std::vector<Change> trail_;
+    std::vector<Decision> decisions_;
+    std::vector<int> worklist_;       // islands whose deductions may have changed
+    std::vector<char> queued_;
+    bool unwinding_ = false;
+    bool finished_ = false;
+    int steps_ = 0;
+    SolveStep last_{SolveEvent::Failed, -1, 0};
+};
@@ -0,0 +1,69 @@
+#include "SpatialIndex.h"
+#include <cstddef>
+#include <memory>
+
+namespace {
+
+// Fills a CSR table from `count` entries, calling each(entry, emit) so the
+// entry can emit(tile) for every tile it touches
+template <typename Each>
+void fillBuckets(int tileCount, int count, std::vector<int>& start, std::vector<int>& list,
+                 Each&& each) {
+    start.assign(tileCount + 1, 0);
+    for (int e = 0; e < count; e++)
+        each(e, [&](int tile) { start[tile + 1]++; });
+    for (int t = 0; t < tileCount; t++)
+        start[t + 1] += start[t];
+
+    list.resize(start[tileCount]);
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int e = 0; e < count; e++)
+        each(e, [&](int tile) { list[fill[tile]++] = e; });
+}
+
+} // namespace
+
+void buildSpatialIndex(GameState& state) {
+    auto built = std::make_shared<SpatialIndex>();
+    state.tiles = built;
+    SpatialIndex& tiles = *built;
+    if (state.islands.empty()) return;
+
+    int minX = state.islands[0].x, maxX = minX;
+    int minY = state.islands[0].y, maxY = minY;
+    for (const auto& island : state.islands) {
+        minX = std::min(minX, island.x);
+        maxX = std::max(maxX, island.x);
+        minY = std::min(minY, island.y);
+        maxY = std::max(maxY, island.y);
+    }
+    // Boards drawn from row and column 0 unless they reach into negatives
+    tiles.originX = std::min(0, minX);
+    tiles.originY = std::min(0, minY);
+    tiles.extentX = maxX - tiles.originX + 1;
+    tiles.extentY = maxY - tiles.originY + 1;
+    tiles.tileRows = (tiles.extentX + TILE_SIZE - 1) / TILE_SIZE;
+    tiles.tileCols = (tiles.extentY + TILE_SIZE - 1) / TILE_SIZE;
+    int tileCount = tiles.tileRows * tiles.tileCols;
+
+    auto tileRow = [&](int x) { return (x - tiles.originX) / TILE_SIZE; };
+    auto tileCol = [&](int y) { return (y - tiles.originY) / TILE_SIZE; };
+
+    fillBuckets(tileCount, static_cast<int>(state.islands.size()), tiles.islandStart, tiles.islandList,
+                [&](int i, auto&& emit) {
+                    const Island& island = state.islands[i];
+                    emit(tileRow(island.x) * tiles.tileCols + tileCol(island.y));
+                });
+
+    // Connections run along one row or column, so they touch a line of tiles
+    fillBuckets(tileCount, static_cast<int>(state.connections.size()), tiles.connectionStart,
+                tiles.connectionList, [&](int c, auto&& emit) {
+                    const Island& a = state.islands[state.index->ends[c].a];
+                    const Island& b = state.islands[state.index->ends[c].b];
+                    int r0 = tileRow(std::min(a.x, b.x)), r1 = tileRow(std::max(a.x, b.x));
+                    int c0 = tileCol(std::min(a.y, b.y)), c1 = tileCol(std::max(a.y, b.y));
+                    for (int tr = r0; tr <= r1; tr++)
+                        for (int tc = c0; tc <= c1; tc++)
+                            emit(tr * tiles.tileCols + tc);
+                });
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "../model/GameState.h"
+#include <algorithm>
+
+// Buckets state.islands and state.connections into TILE_SIZE tiles and
+// points state.tiles at the result. Depends only on the level, so bridge
+// changes never touch it.
+void buildSpatialIndex(GameState& state);
+
+// Calls onIsland(position) and onConnection(index) for everything touching
+// the window of `rows` x `cols` cells at (top, left). Work is proportional
+// to the tiles the window covers and what lies in them. A connection that
+// spans several of those tiles is reported once per tile.
+template <typename OnIsland, typename OnConnection>
+void forEachInWindow(const SpatialIndex& tiles, int top, int left, int rows, int cols,
+                     OnIsland&& onIsland, OnConnection&& onConnection) {
+    if (tiles.tileRows == 0 || rows <= 0 || cols <= 0) return;
+    int firstRow = std::max(0, (top - tiles.originX) / TILE_SIZE);
+    int firstCol = std::max(0, (left - tiles.originY) / TILE_SIZE);
+    int lastRow = std::min(tiles.tileRows - 1, (top + rows - 1 - tiles.originX) / TILE_SIZE);
+    int lastCol = std::min(tiles.tileCols - 1, (left + cols - 1 - tiles.originY) / TILE_SIZE);
+
+    for (int tr = firstRow; tr <= lastRow; tr++) {
+        for (int tc = firstCol; tc <= lastCol; tc++) {
+            int tile = tr * tiles.tileCols + tc;
+            for (int k = tiles.islandStart[tile]; k < tiles.islandStart[tile + 1]; k++)
+                onIsland(tiles.islandList[k]);
+            for (int k = tiles.connectionStart[tile]; k < tiles.connectionStart[tile + 1]; k++)
+                onConnection(tiles.connectionList[k]);
+        }
+    }
+}
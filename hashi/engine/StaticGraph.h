@@ -0,0 +1,99 @@
+#pragma once
+#include "GraphBuilder.h"
+#include "SolveTracker.h"
+#include "SpatialIndex.h"
+#include <array>
+#include <cstddef>
+
+// A level whose connection graph was built entirely at compile time by the
+// constexpr GraphBuilder templates. Islands, connections, adjacency and the
+// crossing table live in read-only storage.
+template <std::size_t N, std::size_t C, std::size_t X>
+struct StaticLevel {
+    std::array<Island, N> islands;
+    std::array<Connection, C> connections;
+    std::array<IslandLinks, N> links;
+    std::array<ConnectionEnds, C> ends;
+    std::array<int, C + 1> conflictStart;
+    std::array<int, 2 * X + 1> conflictList; // +1 keeps the array non-empty
+};
+
+template <std::size_t N>
+constexpr std::size_t countConnections(const std::array<Island, N>& islands) {
+    std::size_t count = 0;
+    forEachConnection(islands, [&](const Connection&) { count++; });
+    return count;
+}
+
+template <std::size_t N, std::size_t C>
+constexpr std::array<Connection, C> buildConnections(const std::array<Island, N>& islands) {
+    std::array<Connection, C> result{};
+    std::size_t next = 0;
+    forEachConnection(islands, [&](const Connection& conn) { result[next++] = conn; });
+    return result;
+}
+
+template <std::size_t N, std::size_t C>
+constexpr std::size_t countCrossings(const std::array<Island, N>& islands,
+                                     const std::array<Connection, C>& connections) {
+    std::size_t count = 0;
+    forEachCrossing(islands, connections, [&](int, int) { count++; });
+    return count;
+}
+
+// Usage: constexpr auto LEVEL = makeStaticLevel<ISLANDS>();
+// where ISLANDS is a constexpr std::array<Island, N> with static storage.
+template <const auto& Islands>
+constexpr auto makeStaticLevel() {
+    constexpr std::size_t N = Islands.size();
+    constexpr std::size_t C = countConnections(Islands);
+    constexpr std::array<Connection, C> connections = buildConnections<N, C>(Islands);
+    constexpr std::size_t X = countCrossings(Islands, connections);
+
+    StaticLevel<N, C, X> level{};
+    level.islands = Islands;
+    level.connections = connections;
+
+    for (std::size_t i = 0; i < N; i++)
+        level.links[i] = IslandLinks{0, {-1, -1, -1, -1}};
+    for (std::size_t c = 0; c < C; c++) {
+        ConnectionEnds ends{islandIndexOf(Islands, connections[c].islandA),
+                            islandIndexOf(Islands, connections[c].islandB)};
+        level.ends[c] = ends;
+        IslandLinks& la = level.links[ends.a];
+        la.connections[la.count++] = static_cast<int>(c);
+        IslandLinks& lb = level.links[ends.b];
+        lb.connections[lb.count++] = static_cast<int>(c);
+    }
+
+    // Crossing pairs flattened into per-connection lists
+    forEachCrossing(Islands, connections, [&](int i, int j) {
+        level.conflictStart[i + 1]++;
+        level.conflictStart[j + 1]++;
+    });
+    for (std::size_t c = 0; c < C; c++)
+        level.conflictStart[c + 1] += level.conflictStart[c];
+
+    std::array<int, C + 1> fill = level.conflictStart;
+    forEachCrossing(Islands, connections, [&](int i, int j) {
+        level.conflictList[fill[i]++] = j;
+        level.conflictList[fill[j]++] = i;
+    });
+
+    return level;
+}
+
+// Copies a compile-time level into `state`; no graph construction happens
+template <std::size_t N, std::size_t C, std::size_t X>
+void loadStaticLevel(GameState& state, const StaticLevel<N, C, X>& level) {
+    state.islands.assign(level.islands.begin(), level.islands.end());
+    state.connections.assign(level.connections.begin(), level.connections.end());
+    auto index = std::make_shared<GraphIndex>();
+    index->links.assign(level.links.begin(), level.links.end());
+    index->ends.assign(level.ends.begin(), level.ends.end());
+    index->conflictStart.assign(level.conflictStart.begin(), level.conflictStart.end());
+    index->conflictList.assign(level.conflictList.begin(), level.conflictList.begin() + 2 * X);
+    state.index = std::move(index);
+    buildSpatialIndex(state);
+    rebuildProgress(state);
+}
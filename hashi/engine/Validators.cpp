@@ -1,20 +1,49 @@
 #include "Validators.h"
 #include "GameUtils.h"
+#include "Profiler.h"
+#include "SolveTracker.h"
+#include <cassert>
+#include <cstddef>
 
 bool validateCrossings(const GameState& state) {
-    // In this simplified version, we don't check bridge crossings
-    // This can be implemented later for more complex validation
+    // Straight from the bridge counts and the crossing table
+    const GraphIndex& index = *state.index;
+    for (std::size_t i = 0; i < state.connections.size(); i++) {
+        if (state.connections[i].bridges == 0) continue;
+        for (int k = index.conflictStart[i]; k < index.conflictStart[i + 1]; k++) {
+            if (state.connections[index.conflictList[k]].bridges > 0) return false;
+        }
+    }
     return true;
 }
 
-bool isSolved(const GameState& state) {
+bool isSolvedFull(const GameState& state) {
     // Check if all islands have their required degree
     for (const auto& island : state.islands) {
-        if (currentDegree(state, island.id) != island.requiredDegree) {
+        int sum = 0;
+        for (const auto& c : state.connections) {
+            if (c.islandA == island.id || c.islandB == island.id)
+                sum += c.bridges;
+        }
+        if (sum != island.requiredDegree) {
             return false;
         }
     }
     
-    // Check if all islands are connected
-    return validateConnectivity(state);
+    // Bridges must not cross, and all islands must be connected
+    return validateCrossings(state) && validateConnectivity(state);
+}
+
+bool isDeadEnd(const GameState& state) {
+    return progressDeadEnd(state);
+}
+
+bool isSolved(const GameState& state) {
+    HASHI_PROFILE_SCOPE(ProfilePoint::IsSolved);
+    // Moves keep the solved summary up to date, so this is a constant-time read
+    bool solved = progressSolved(state);
+#ifdef DEBUG
+    assert(solved == isSolvedFull(state));
+#endif
+    return solved;
 }
\ No newline at end of file
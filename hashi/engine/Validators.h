@@ -4,4 +4,10 @@
 int currentDegree(const GameState& state, int islandId);
 bool validateCrossings(const GameState& state);
 bool validateConnectivity(const GameState& state);
+// O(1), from the progress summary maintained by every move
 bool isSolved(const GameState& state);
+// O(1): true if the position can no longer be completed without removing
+// bridges (see progressDeadEnd)
+bool isDeadEnd(const GameState& state);
+// Recomputes everything from the bridge counts; for checking and tools
+bool isSolvedFull(const GameState& state);
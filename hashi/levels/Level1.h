@@ -1,15 +0,0 @@
-#pragma once
-#include "../model/Island.h"
-#include <vector>
-
-inline std::vector<Island> createLevel1() {
-    return {
-        {1,1,1,2}, {2,1,3,4}, {3,1,6,1},
-        {4,2,4,4}, {5,2,7,2},
-        {6,3,1,4}, {7,3,3,5},
-        {8,4,4,3}, {9,4,6,1},
-        {10,5,3,3}, {11,5,5,5}, {12,5,7,4},
-        {13,6,1,2}, {14,6,4,1},
-        {15,7,1,1}, {16,7,5,2}, {17,7,7,1}
-    };
-}
@@ -0,0 +1,211 @@
+#include "LevelCatalog.h"
+#include "LevelManager.h"
+#include "../engine/GraphBuilder.h"
+#include "../engine/Snapshot.h"
+#include "../engine/SolveTracker.h"
+#include "../engine/SpatialIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+template <typename T>
+std::size_t vectorBytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+std::size_t graphBytes(const LevelGraph& graph) {
+    return sizeof(LevelGraph) + vectorBytes(graph.islands) + vectorBytes(graph.connections) +
+           vectorBytes(graph.index->links) + vectorBytes(graph.index->ends) +
+           vectorBytes(graph.index->conflictStart) + vectorBytes(graph.index->conflictList) +
+           vectorBytes(graph.tiles->islandStart) + vectorBytes(graph.tiles->islandList) +
+           vectorBytes(graph.tiles->connectionStart) + vectorBytes(graph.tiles->connectionList);
+}
+
+// "id x y degree" per line; blank lines and '#' comments are skipped. Gives
+// up once the file holds more islands than any level may have.
+bool readIslandList(const std::string& path, std::vector<Island>& islands) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        Island island{};
+        if (!(fields >> island.id)) continue;
+        if (!(fields >> island.x >> island.y >> island.requiredDegree)) return false;
+        if (islands.size() == MAX_LEVEL_ISLANDS) return false;
+        islands.push_back(island);
+    }
+    return true;
+}
+
+// File name "<id>.<ext>" -> id, or -1 if the stem is not all digits or
+// does not fit an int
+int levelIdFromName(const std::filesystem::path& file) {
+    std::string stem = file.stem().string();
+    bool digits = std::all_of(stem.begin(), stem.end(), [](unsigned char c) { return std::isdigit(c); });
+    if (stem.empty() || !digits) return -1;
+    int id = -1;
+    const char* end = stem.data() + stem.size();
+    auto [last, error] = std::from_chars(stem.data(), end, id);
+    if (error != std::errc() || last != end) return -1;
+    return id;
+}
+
+} // namespace
+
+LevelCatalog::LevelCatalog(std::size_t cacheBytes) : budget_(cacheBytes) {}
+
+void LevelCatalog::addBuiltinLevels() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int id = 1; !createLevel(id).empty(); id++)
+        sources_[id] = Source{true, {}};
+}
+
+void LevelCatalog::addLevelFile(int id, const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sources_[id] = Source{false, path};
+    // A re-registered id must not keep serving the old graph
+    auto it = cache_.find(id);
+    if (it != cache_.end()) {
+        stats_.cachedBytes -= it->second.graph->bytes;
+        recent_.erase(it->second.position);
+        cache_.erase(it);
+    }
+}
+
+int LevelCatalog::scanDirectory(const std::string& dir, std::vector<std::string>* duplicates) {
+    // Sorted, so which of two files naming the same id wins does not depend
+    // on directory order
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+        const std::filesystem::path& file = entry.path();
+        if (file.extension() == ".hlvl" || file.extension() == ".txt") files.push_back(file);
+    }
+    std::sort(files.begin(), files.end());
+
+    std::unordered_map<int, std::string> claimed;
+    for (const auto& file : files) {
+        int id = levelIdFromName(file);
+        if (id < 0) continue;
+        if (!claimed.emplace(id, file.string()).second) {
+            if (duplicates) duplicates->push_back(file.string() + " (same id as " + claimed[id] + ")");
+            continue;
+        }
+        addLevelFile(id, file.string());
+    }
+    return static_cast<int>(claimed.size());
+}
+
+bool LevelCatalog::contains(int id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sources_.count(id) > 0;
+}
+
+std::vector<int> LevelCatalog::ids() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> result;
+    result.reserve(sources_.size());
+    for (const auto& source : sources_) result.push_back(source.first);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::shared_ptr<const LevelGraph> LevelCatalog::acquire(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cached = cache_.find(id);
+    if (cached != cache_.end()) {
+        stats_.hits++;
+        recent_.splice(recent_.begin(), recent_, cached->second.position);
+        return cached->second.graph;
+    }
+
+    auto source = sources_.find(id);
+    if (source == sources_.end()) return nullptr;
+    std::shared_ptr<const LevelGraph> graph = build(id, source->second);
+    if (!graph) return nullptr;
+
+    stats_.misses++;
+    recent_.push_front(id);
+    cache_[id] = Entry{graph, recent_.begin()};
+    stats_.cachedBytes += graph->bytes;
+    evictOverBudget(id);
+    return graph;
+}
+
+LevelCatalog::Stats LevelCatalog::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats result = stats_;
+    result.cachedLevels = cache_.size();
+    return result;
+}
+
+std::shared_ptr<const LevelGraph> LevelCatalog::build(int id, const Source& source) const {
+    // Built in a scratch GameState so the usual builders can be reused
+    GameState scratch;
+    try {
+        if (source.builtin) {
+            if (!loadBuiltinLevel(scratch, id)) return nullptr;
+        } else if (std::filesystem::path(source.path).extension() == ".hlvl") {
+            std::vector<uint8_t> data;
+            if (!readBinaryFile(source.path, data) ||
+                !readLevelRecord(data, scratch.islands, scratch.connections)) {
+                return nullptr;
+            }
+            scratch.index = std::make_shared<const GraphIndex>(
+                computeGraphIndex(scratch.islands, scratch.connections));
+            buildSpatialIndex(scratch);
+        } else {
+            // Checked before anything is built; the connections found for a
+            // valid island list are valid by construction
+            if (!readIslandList(source.path, scratch.islands) || scratch.islands.empty() ||
+                !isValidIslandList(scratch.islands)) {
+                return nullptr;
+            }
+            scratch.connections = computeConnections(scratch.islands);
+            scratch.index = std::make_shared<const GraphIndex>(
+                computeGraphIndex(scratch.islands, scratch.connections));
+            buildSpatialIndex(scratch);
+        }
+    } catch (const std::exception&) {
+        // Out of memory, or a graph the checks above let through
+        return nullptr;
+    }
+
+    auto graph = std::make_shared<LevelGraph>();
+    graph->islands = std::move(scratch.islands);
+    graph->connections = std::move(scratch.connections);
+    for (auto& conn : graph->connections) conn.bridges = 0;
+    graph->index = std::move(scratch.index);
+    graph->tiles = std::move(scratch.tiles);
+    graph->bytes = graphBytes(*graph);
+    return graph;
+}
+
+void LevelCatalog::evictOverBudget(int keep) {
+    // Least recently used first; the level just requested always stays
+    while (stats_.cachedBytes > budget_ && recent_.size() > 1) {
+        int victim = recent_.back();
+        if (victim == keep) break;
+        auto it = cache_.find(victim);
+        stats_.cachedBytes -= it->second.graph->bytes;
+        cache_.erase(it);
+        recent_.pop_back();
+        stats_.evictions++;
+    }
+}
+
+void loadLevelGraph(GameState& state, const LevelGraph& graph) {
+    state.islands = graph.islands;
+    state.connections = graph.connections;
+    state.index = graph.index;   // shared, not copied
+    state.tiles = graph.tiles;
+    rebuildProgress(state);
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "../model/GameState.h"
+#include "../model/LevelGraph.h"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Default memory budget for built level graphs
+const std::size_t DEFAULT_LEVEL_CACHE_BYTES = std::size_t(64) << 20;
+
+// Levels known to the program, by id. Registering a level only records where
+// it comes from; its graph is built on first use and kept in an LRU cache
+// bounded by total graph size. Graphs handed out stay valid after eviction
+// for as long as someone holds them, and states loaded from a graph keep
+// its shared tables alive the same way. Files that fail isValidLevelGraph
+// are never built.
+//
+// Level files are named "<id>.hlvl" (a level record, see Snapshot.h) or
+// "<id>.txt" (one "id x y degree" island per line, '#' starts a comment).
+class LevelCatalog {
+public:
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+        std::size_t cachedLevels = 0;
+        std::size_t cachedBytes = 0;
+    };
+
+    explicit LevelCatalog(std::size_t cacheBytes = DEFAULT_LEVEL_CACHE_BYTES);
+
+    // Registers the compiled-in levels 1-3
+    void addBuiltinLevels();
+    void addLevelFile(int id, const std::string& path);
+    // Registers every level file in `dir`; returns how many were registered.
+    // Of several files naming the same id (7.txt, 007.txt, 7.hlvl) only the
+    // first by name is kept; the others are listed in `duplicates`.
+    int scanDirectory(const std::string& dir, std::vector<std::string>* duplicates = nullptr);
+
+    bool contains(int id) const;
+    std::vector<int> ids() const;
+
+    // The built graph for `id`, or nullptr if the id is unknown or its file
+    // cannot be read or describes an invalid level
+    std::shared_ptr<const LevelGraph> acquire(int id);
+
+    Stats stats() const;
+
+private:
+    struct Source {
+        bool builtin;
+        std::string path;
+    };
+
+    struct Entry {
+        std::shared_ptr<const LevelGraph> graph;
+        std::list<int>::iterator position;   // in recent_
+    };
+
+    std::shared_ptr<const LevelGraph> build(int id, const Source& source) const;
+    void evictOverBudget(int keep);
+
+    std::size_t budget_;
+    std::unordered_map<int, Source> sources_;
+    std::unordered_map<int, Entry> cache_;
+    std::list<int> recent_;                    // most recently used first
+    Stats stats_;
+    mutable std::mutex mutex_;
+};
+
+// Loads a built graph into `state` with all bridges cleared: islands and
+// connections are copied, the index and tiles shared
+void loadLevelGraph(GameState& state, const LevelGraph& graph);
@@ -1,44 +1,80 @@
 #include "LevelManager.h"
+#include "../engine/StaticGraph.h"
+
+namespace {
+
+// Built-in levels. Their connection graphs are generated at compile time.
+constexpr std::array<Island, 17> LEVEL1_ISLANDS = {{
+    {1, 1, 1, 2},   // Island ID, x, y, required degree
+    {2, 1, 3, 4},
+    {3, 1, 6, 1},
+    {4, 2, 4, 4},
+    {5, 2, 7, 2},
+    {6, 3, 1, 4},
+    {7, 3, 3, 5},
+    {8, 4, 4, 3},
+    {9, 4, 6, 1},
+    {10, 5, 3, 3},
+    {11, 5, 5, 5},
+    {12, 5, 7, 4},
+    {13, 6, 1, 2},
+    {14, 6, 4, 1},
+    {15, 7, 1, 1},
+    {16, 7, 5, 2},
+    {17, 7, 7, 1}
+}};
+
+constexpr std::array<Island, 6> LEVEL2_ISLANDS = {{
+    {1, 0, 2, 1},
+    {2, 1, 0, 2},
+    {3, 1, 4, 2},
+    {4, 2, 2, 3},
+    {5, 3, 0, 1},
+    {6, 3, 4, 1}
+}};
+
+constexpr std::array<Island, 5> LEVEL3_ISLANDS = {{
+    {1, 0, 0, 1},
+    {2, 0, 4, 2},
+    {3, 2, 2, 4},
+    {4, 4, 0, 1},
+    {5, 4, 4, 2}
+}};
+
+constexpr auto LEVEL1 = makeStaticLevel<LEVEL1_ISLANDS>();
+constexpr auto LEVEL2 = makeStaticLevel<LEVEL2_ISLANDS>();
+constexpr auto LEVEL3 = makeStaticLevel<LEVEL3_ISLANDS>();
+
+static_assert(LEVEL1.connections.size() == 21, "level 1 graph changed");
+
+} // namespace
 
 std::vector<Island> createLevel1() {
-    return {
-        {1, 1, 1, 2},   // Island ID, x, y, required degree
-        {2, 1, 3, 4},
-        {3, 1, 6, 1},
-        {4, 2, 4, 4},
-        {5, 2, 7, 2},
-        {6, 3, 1, 4},
-        {7, 3, 3, 5},
-        {8, 4, 4, 3},
-        {9, 4, 6, 1},
-        {10, 5, 3, 3},
-        {11, 5, 5, 5},
-        {12, 5, 7, 4},
-        {13, 6, 1, 2},
-        {14, 6, 4, 1},
-        {15, 7, 1, 1},
-        {16, 7, 5, 2},
-        {17, 7, 7, 1}
-    };
+    return {LEVEL1_ISLANDS.begin(), LEVEL1_ISLANDS.end()};
 }
 
 std::vector<Island> createLevel2() {
-    return {
-        {1, 0, 2, 1},
-        {2, 1, 0, 2},
-        {3, 1, 4, 2},
-        {4, 2, 2, 3},
-        {5, 3, 0, 1},
-        {6, 3, 4, 1}
-    };
+    return {LEVEL2_ISLANDS.begin(), LEVEL2_ISLANDS.end()};
 }
 
 std::vector<Island> createLevel3() {
-    return {
-        {1, 0, 0, 1},
-        {2, 0, 4, 2},
-        {3, 2, 2, 4},
-        {4, 4, 0, 1},
-        {5, 4, 4, 2}
-    };
-}
\ No newline at end of file
+    return {LEVEL3_ISLANDS.begin(), LEVEL3_ISLANDS.end()};
+}
+
+std::vector<Island> createLevel(int levelNumber) {
+    switch (levelNumber) {
+        case 1: return createLevel1();
+        case 2: return createLevel2();
+        case 3: return createLevel3();
+        default: return {};
+    }
+}
+
+bool loadBuiltinLevel(GameState& state, int levelNumber) {
+    switch (levelNumber) {
+        case 1: loadStaticLevel(state, LEVEL1); return true;
+        case 2: loadStaticLevel(state, LEVEL2); return true;
+        case 3: loadStaticLevel(state, LEVEL3); return true;
+        default: return false;
+    }
+}
@@ -1,7 +1,15 @@
 #pragma once
 #include "../model/Island.h"
+#include "../model/GameState.h"
 #include <vector>
 
 std::vector<Island> createLevel1();
 std::vector<Island> createLevel2();
-std::vector<Island> createLevel3();
\ No newline at end of file
+std::vector<Island> createLevel3();
+
+// Returns the islands for a numbered level, or an empty list if unknown
+std::vector<Island> createLevel(int levelNumber);
+
+// Loads a built-in level with its precomputed (compile-time) connection
+// graph. Returns false if there is no such level.
+bool loadBuiltinLevel(GameState& state, int levelNumber);
@@ -1,21 +1,104 @@
 #include "model/GameState.h"
-#include "engine/GraphBuilder.h"
+#include "engine/Profiler.h"
 #include "engine/Validators.h"
-#include "levels/LevelManager.h"
+#include "levels/LevelCatalog.h"
+#include "server/SessionServer.h"
 #include "ui/ConsoleUI.h"
+#include "ui/ReplayDriver.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
 
-int main() {
-    // Create game state
-    GameState state;
-    
-    // Load level 1
-    state.islands = createLevel1();
-    
-    // Compute all possible connections
-    state.connections = computeConnections(state.islands);
-    
-    // Start the console interface
-    runConsoleGame(state);
-    
-    return 0;
+int main(int argc, char* argv[]) {
+    std::string serverSocket;
+    std::string profileOut;
+    std::string replayScript;
+    std::string captureFile;
+    std::string levelDir;
+    int level = 1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--server" && i + 1 < argc) {
+            serverSocket = argv[++i];
+        } else if (arg == "--profile-out" && i + 1 < argc) {
+            profileOut = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayScript = argv[++i];
+        } else if (arg == "--capture" && i + 1 < argc) {
+            captureFile = argv[++i];
+        } else if (arg == "--level" && i + 1 < argc) {
+            level = std::atoi(argv[++i]);
+        } else if (arg == "--levels" && i + 1 < argc) {
+            levelDir = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--level <n>] [--levels <dir>]"
+                      << " [--server <socket path>] [--profile-out <file.json>]\n"
+                      << "       [--replay <script> [--capture <file>]]\n";
+            return 1;
+        }
+    }
+
+    // Built-in levels plus any level files; nothing is read until played
+    LevelCatalog catalog;
+    catalog.addBuiltinLevels();
+    if (!levelDir.empty()) {
+        std::vector<std::string> duplicates;
+        if (catalog.scanDirectory(levelDir, &duplicates) == 0)
+            std::cerr << "No level files found in " << levelDir << "\n";
+        for (const auto& file : duplicates)
+            std::cerr << "Ignoring level file " << file << "\n";
+    }
+
+    int status = 0;
+    if (!serverSocket.empty()) {
+        // Server mode: host many sessions over a Unix domain socket
+        status = runSessionServer(serverSocket, catalog) ? 0 : 1;
+    } else {
+        // Create game state
+        GameState state;
+
+        // Load the level (built on first use, then cached)
+        std::shared_ptr<const LevelGraph> graph = catalog.acquire(level);
+        if (!graph) {
+            std::cerr << (catalog.contains(level) ? "Invalid level " : "Unknown level ") << level << "\n";
+            return 1;
+        }
+        loadLevelGraph(state, *graph);
+
+        if (!replayScript.empty()) {
+            // Headless replay: same command dispatch, no terminal
+            std::ifstream script(replayScript);
+            std::ofstream capture;
+            if (!script) {
+                std::cerr << "Could not open script " << replayScript << "\n";
+                return 1;
+            }
+            if (!captureFile.empty()) {
+                capture.open(captureFile);
+                if (!capture) {
+                    std::cerr << "Could not open capture file " << captureFile << "\n";
+                    return 1;
+                }
+            }
+            std::ostream& sink = captureFile.empty() ? nullOutput() : capture;
+            runHeadlessReplay(state, script, sink, std::cout);
+        } else {
+            // Start the console interface
+            runConsoleGame(state);
+        }
+    }
+
+    if (!profileOut.empty()) {
+        std::ofstream out(profileOut);
+        if (!out) {
+            std::cerr << "Could not write profile to " << profileOut << "\n";
+            return 1;
+        }
+        writeProfileJson(collectProfile(), out);
+    }
+
+    return status;
 }
@@ -1,9 +1,23 @@
 #pragma once
+#include <memory>
 #include <vector>
 #include "Island.h"
 #include "Connection.h"
+#include "GraphIndex.h"
+#include "SolveProgress.h"
+#include "LegalMoves.h"
+#include "SpatialIndex.h"
 
+// The level-only tables (index, tiles) never change once built, so states
+// playing the same level share them rather than holding copies; a loader
+// replaces the pointer, nothing writes through it.
 struct GameState {
     std::vector<Island> islands;
     std::vector<Connection> connections;
+    std::shared_ptr<const GraphIndex> index =
+        std::make_shared<const GraphIndex>();       // derived from islands/connections, see GraphBuilder
+    SolveProgress progress;  // derived from bridge counts, see SolveTracker
+    LegalMoves legal;        // derived from bridge counts, see SolveTracker
+    std::shared_ptr<const SpatialIndex> tiles =
+        std::make_shared<const SpatialIndex>();     // derived from islands/connections, see SpatialIndex
 };
@@ -0,0 +1,23 @@
+#pragma once
+#include <vector>
+
+// Incident connections of one island (at most one per direction)
+struct IslandLinks {
+    int count;
+    int connections[4]; // indices into GameState::connections
+};
+
+// Positions in GameState::islands of a connection's two islands
+struct ConnectionEnds {
+    int a;
+    int b;
+};
+
+// Lookup tables derived from a level's islands and connections. They depend
+// only on the level, never on bridge counts, so they are built once per level.
+struct GraphIndex {
+    std::vector<IslandLinks> links;      // one per island
+    std::vector<ConnectionEnds> ends;    // one per connection
+    std::vector<int> conflictStart;      // one per connection, plus an end marker
+    std::vector<int> conflictList;       // connections whose bridges would cross
+};
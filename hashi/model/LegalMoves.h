@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Which connections can take one more bridge right now, one bit per
+// connection, kept current by every bridge change (see engine/SolveTracker).
+// A connection is addable when it has fewer than 2 bridges, neither island
+// is at its required degree, and no bridge crosses its span.
+struct LegalMoves {
+    std::vector<uint64_t> addable;    // bit c set if connection c is addable
+    std::vector<int> crossBlockers;   // per connection: crossing connections with bridges
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Island.h"
+#include "Connection.h"
+#include "GraphIndex.h"
+#include "SpatialIndex.h"
+
+// Everything about a level that does not depend on bridge counts; bridges
+// in `connections` are always 0. Sessions playing the level share `index`
+// and `tiles`, and copy only the islands and connections, since those carry
+// the session's bridge counts.
+struct LevelGraph {
+    std::vector<Island> islands;
+    std::vector<Connection> connections;
+    std::shared_ptr<const GraphIndex> index;
+    std::shared_ptr<const SpatialIndex> tiles;
+    std::size_t bytes = 0;   // approximate heap footprint
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <vector>
+
+// Running summary of how close the board is to solved, kept current by
+// every bridge change (see engine/SolveTracker) so checks are O(1) reads.
+struct SolveProgress {
+    std::vector<int> degree;        // current bridges per island position
+    int satisfiedIslands = 0;       // islands whose degree equals their requirement
+    std::vector<int> parent;        // union-find over islands joined by bridges
+    int components = 0;             // valid unless componentsStale
+    bool componentsStale = false;   // a bridge was removed since the last rebuild
+
+    // Dead-end detectors: positions that cannot be completed without
+    // removing bridges
+    std::vector<char> shortOfCapacity;   // per island: needs more than neighbours can still give
+    int shortIslands = 0;
+    std::vector<char> closedOff;         // per island: in a saturated component missing other islands
+    int closedIslands = 0;
+    std::vector<unsigned> visitStamp;    // scratch marks for component walks
+    unsigned stamp = 0;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <vector>
+
+// Edge length, in cells, of one square tile of the spatial index
+const int TILE_SIZE = 16;
+
+// Islands and connections bucketed by the tiles they touch, so a window of
+// the board can be drawn without scanning the whole level. Each tile's
+// entries are a slice of the flat lists, as in GraphIndex.
+struct SpatialIndex {
+    int originX = 0;                     // top-left cell of tile (0, 0)
+    int originY = 0;
+    int extentX = 0;                     // rows and columns from the origin to the last island
+    int extentY = 0;
+    int tileRows = 0;
+    int tileCols = 0;
+    std::vector<int> islandStart;        // one per tile, plus an end marker
+    std::vector<int> islandList;         // island positions
+    std::vector<int> connectionStart;    // one per tile, plus an end marker
+    std::vector<int> connectionList;     // connections whose span or ends touch the tile
+};
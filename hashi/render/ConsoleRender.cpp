@@ -1,120 +1,153 @@
 #include "ConsoleRender.h"
 #include "../engine/GameUtils.h"
+#include "../engine/Moves.h"
+#include "../engine/Profiler.h"
+#include "../engine/SpatialIndex.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
-const int GRID_SIZE = 8;
+namespace {
 
-void renderMap(const GameState& state) {
-    // Create a grid to display
-    std::string grid[GRID_SIZE][GRID_SIZE];
-    
-    // Initialize grid with empty spaces
-    for(int i = 0; i < GRID_SIZE; i++) {
-        for(int j = 0; j < GRID_SIZE; j++) {
-            grid[i][j] = " · ";
-        }
-    }
-    
-    // Add connections to the grid first
-    for(const Connection& conn : state.connections) {
-        if(conn.bridges > 0) {
-            // Find the island positions
-            Island islandA, islandB;
-            for(const Island& island : state.islands) {
-                if(island.id == conn.islandA) islandA = island;
-                if(island.id == conn.islandB) islandB = island;
-            }
-            
-            // Draw bridges between islands
-            if(conn.orientation == Orientation::HORIZONTAL) {
-                int row = islandA.x;
-                int startCol = std::min(islandA.y, islandB.y);
-                int endCol = std::max(islandA.y, islandB.y);
-                
-                for(int col = startCol + 1; col < endCol; col++) {
-                    if(conn.bridges == 1) {
-                        grid[row][col] = " — ";
-                    } else if(conn.bridges == 2) {
-                        grid[row][col] = " = ";
-                    }
-                }
-            } else if(conn.orientation == Orientation::VERTICAL) {
-                int col = islandA.y;
-                int startRow = std::min(islandA.x, islandB.x);
-                int endRow = std::max(islandA.x, islandB.x);
-                
-                for(int row = startRow + 1; row < endRow; row++) {
-                    if(conn.bridges == 1) {
-                        grid[row][col] = " | ";
-                    } else if(conn.bridges == 2) {
-                        grid[row][col] = " ‖ ";
-                    }
-                }
-            }
-        }
-    }
-    
-    // Place islands on the grid
-    for(const Island& island : state.islands) {
-        if(island.x >= 0 && island.x < GRID_SIZE && island.y >= 0 && island.y < GRID_SIZE) {
-            grid[island.x][island.y] = std::string(" ") + char('0' + island.requiredDegree) + " ";
+const char* const DEGREE_GLYPHS[] = {" 0 ", " 1 ", " 2 ", " 3 ", " 4 ", " 5 ", " 6 ", " 7 ", " 8 "};
+
+enum class Cell : char { Water, Island, Bridge };
+
+void printRule(std::ostream& out, const char* left, const char* right, int width) {
+    out << left;
+    for (int i = 0; i < width; i++) out << "═";
+    out << right << std::endl;
+}
+
+// Very narrow viewports cut the text rather than break the frame
+void printCentered(std::ostream& out, const std::string& text, int width) {
+    std::string shown = text.substr(0, width);
+    int pad = width - static_cast<int>(shown.size());
+    out << "║" << std::string(pad / 2, ' ') << shown << std::string(pad - pad / 2, ' ') << "║" << std::endl;
+}
+
+} // namespace
+
+Viewport fitViewport(const GameState& state, int maxRows, int maxCols) {
+    const SpatialIndex& tiles = *state.tiles;
+    if (tiles.tileRows == 0) return Viewport{};
+    return Viewport{tiles.originX, tiles.originY,
+                    std::min(maxRows, tiles.extentX), std::min(maxCols, tiles.extentY)};
+}
+
+void panViewport(const GameState& state, Viewport& view, int dRows, int dCols) {
+    const SpatialIndex& tiles = *state.tiles;
+    int lastTop = tiles.originX + std::max(0, tiles.extentX - view.rows);
+    int lastLeft = tiles.originY + std::max(0, tiles.extentY - view.cols);
+    view.top = std::clamp(view.top + dRows, tiles.originX, lastTop);
+    view.left = std::clamp(view.left + dCols, tiles.originY, lastLeft);
+}
+
+void renderMap(const GameState& state, std::ostream& out, const Viewport& view) {
+    HASHI_PROFILE_SCOPE(ProfilePoint::RenderMap);
+    int rows = std::max(view.rows, 1);
+    int cols = std::max(view.cols, 1);
+    std::vector<const char*> glyph(rows * cols, " · ");
+    std::vector<Cell> kind(rows * cols, Cell::Water);
+    auto put = [&](int x, int y, const char* g, Cell k) {
+        int i = (x - view.top) * cols + (y - view.left);
+        glyph[i] = g;
+        kind[i] = k;
+    };
+
+    // Only what the spatial index places under the viewport is visited. A
+    // long span shows up in every tile it crosses, so draw each one once.
+    std::vector<int> visible;
+    forEachInWindow(*state.tiles, view.top, view.left, rows, cols,
+        [&](int) {},
+        [&](int c) {
+            if (state.connections[c].bridges > 0) visible.push_back(c);
+        });
+    std::sort(visible.begin(), visible.end());
+    visible.erase(std::unique(visible.begin(), visible.end()), visible.end());
+
+    // Spans are clipped to the window before drawing
+    for (int c : visible) {
+        const Connection& conn = state.connections[c];
+        const Island& a = state.islands[state.index->ends[c].a];
+        const Island& b = state.islands[state.index->ends[c].b];
+
+        if (conn.orientation == Orientation::HORIZONTAL) {
+            if (a.x < view.top || a.x >= view.top + rows) continue;
+            int from = std::max(std::min(a.y, b.y) + 1, view.left);
+            int to = std::min(std::max(a.y, b.y) - 1, view.left + cols - 1);
+            for (int y = from; y <= to; y++)
+                put(a.x, y, conn.bridges == 1 ? " — " : " = ", Cell::Bridge);
+        } else {
+            if (a.y < view.left || a.y >= view.left + cols) continue;
+            int from = std::max(std::min(a.x, b.x) + 1, view.top);
+            int to = std::min(std::max(a.x, b.x) - 1, view.top + rows - 1);
+            for (int x = from; x <= to; x++)
+                put(x, a.y, conn.bridges == 1 ? " | " : " ‖ ", Cell::Bridge);
         }
     }
-    
+
+    // Islands go on top of any bridge glyphs
+    forEachInWindow(*state.tiles, view.top, view.left, rows, cols,
+        [&](int i) {
+            const Island& island = state.islands[i];
+            if (island.x < view.top || island.x >= view.top + rows ||
+                island.y < view.left || island.y >= view.left + cols) return;
+            int degree = std::clamp(island.requiredDegree, 0, 8);
+            put(island.x, island.y, DEGREE_GLYPHS[degree], Cell::Island);
+        },
+        [&](int) {});
+
     // Print the grid
-    std::cout << "\n╔══════════════════════════════════════════════════╗" << std::endl;
-    std::cout << "║         HASHIWOKAKERO PUZZLE SOLUTION            ║" << std::endl;
-    std::cout << "╠══════════════════════════════════════════════════╣" << std::endl;
-    std::cout << "║      ";
-    
-    // Print column headers
-    for(int j = 0; j < GRID_SIZE; j++) {
-        std::cout << " " << j << "  ";
+    int width = 7 + 3 * cols;
+    out << "\n";
+    printRule(out, "╔", "╗", width);
+    printCentered(out, "HASHIWOKAKERO PUZZLE", width);
+    printCentered(out, "rows " + std::to_string(view.top) + "-" + std::to_string(view.top + rows - 1) +
+                       "  cols " + std::to_string(view.left) + "-" + std::to_string(view.left + cols - 1),
+                  width);
+    printRule(out, "╠", "╣", width);
+
+    // Column headers (last two digits; the range above gives the rest)
+    out << "║       ";
+    for (int j = 0; j < cols; j++) {
+        out << " " << std::setw(2) << (view.left + j) % 100;
     }
-    std::cout << "    ║" << std::endl;
-    std::cout << "╠══════════════════════════════════════════════════╣" << std::endl;
-    
+    out << "║" << std::endl;
+    printRule(out, "╠", "╣", width);
+
     // Print each row
-    for(int i = 0; i < GRID_SIZE; i++){
-        std::cout << "║  " << i << " ║";
-        for(int j = 0; j < GRID_SIZE; j++){
-            if(grid[i][j].find('0') != std::string::npos || 
-               grid[i][j].find('1') != std::string::npos || 
-               grid[i][j].find('2') != std::string::npos || 
-               grid[i][j].find('3') != std::string::npos || 
-               grid[i][j].find('4') != std::string::npos || 
-               grid[i][j].find('5') != std::string::npos || 
-               grid[i][j].find('6') != std::string::npos || 
-               grid[i][j].find('7') != std::string::npos || 
-               grid[i][j].find('8') != std::string::npos || 
-               grid[i][j].find('9') != std::string::npos) {
+    for (int i = 0; i < rows; i++) {
+        out << "║" << std::setw(5) << view.top + i << " ║";
+        for (int j = 0; j < cols; j++) {
+            int cell = i * cols + j;
+            if (kind[cell] == Cell::Island) {
                 // Island - color in cyan
-                std::cout << "\033[1;36m" << grid[i][j] << "\033[0m";
-            } else if(grid[i][j].find("—") != std::string::npos || 
-                      grid[i][j].find("=") != std::string::npos || 
-                      grid[i][j].find("|") != std::string::npos || 
-                      grid[i][j].find("‖") != std::string::npos) {
+                out << "\033[1;36m" << glyph[cell] << "\033[0m";
+            } else if (kind[cell] == Cell::Bridge) {
                 // Bridge - color in yellow
-                std::cout << "\033[1;33m" << grid[i][j] << "\033[0m";
+                out << "\033[1;33m" << glyph[cell] << "\033[0m";
             } else {
                 // Empty water
-                std::cout << grid[i][j];
+                out << glyph[cell];
             }
         }
-        std::cout << "║" << std::endl;
+        out << "║" << std::endl;
     }
-    std::cout << "╚══════════════════════════════════════════════════╝" << std::endl;
+    printRule(out, "╚", "╝", width);
 }
 
-void renderConnections(const GameState& state) {
-    std::cout << "\n\033[1;33mAvailable Connections:\033[0m\n";
-    std::cout << "\033[1;37m" << std::setw(4) << "ID" << " | " << std::setw(10) << "Islands" 
+void renderConnections(const GameState& state, std::ostream& out, bool legalOnly) {
+    out << (legalOnly ? "\n\033[1;33mLegal Moves:\033[0m\n" : "\n\033[1;33mAvailable Connections:\033[0m\n");
+    out << "\033[1;37m" << std::setw(4) << "ID" << " | " << std::setw(10) << "Islands" 
          << " | " << std::setw(11) << "Orientation" << " | " << std::setw(8) << "Bridges" << "\033[0m\n";
-    std::cout << "\033[1;30m" << std::string(45, '-') << "\033[0m\n";
+    out << "\033[1;30m" << std::string(45, '-') << "\033[0m\n";
     
     for (size_t i = 0; i < state.connections.size(); i++) {
+        if (legalOnly && !isLegalToggle(state, static_cast<int>(i))) continue;
+
         const auto& c = state.connections[i];
         std::string orientation = (c.orientation == Orientation::HORIZONTAL) ? "Horizontal" : "Vertical";
         std::string bridgeDisplay = "";
@@ -127,18 +160,18 @@ void renderConnections(const GameState& state) {
         if (c.bridges == 1) color = "\033[1;33m";
         else if (c.bridges == 2) color = "\033[1;31m";
         
-        std::cout << color << std::setw(4) << i << " | " 
+        out << color << std::setw(4) << i << " | " 
              << std::setw(4) << c.islandA << " <-> " << std::setw(2) << c.islandB 
              << " | " << std::setw(11) << orientation 
              << " | " << std::setw(8) << bridgeDisplay << "\033[0m\n";
     }
 }
 
-void renderStats(const GameState& state) {
-    std::cout << "\n\033[1;36mGame Statistics:\033[0m\n";
-    std::cout << "\033[1;37m" << std::setw(8) << "Island" << " | " << std::setw(15) << "Current/Required" 
+void renderStats(const GameState& state, std::ostream& out) {
+    out << "\n\033[1;36mGame Statistics:\033[0m\n";
+    out << "\033[1;37m" << std::setw(8) << "Island" << " | " << std::setw(15) << "Current/Required" 
          << " | " << std::setw(8) << "Status" << "\033[0m\n";
-    std::cout << "\033[1;30m" << std::string(35, '-') << "\033[0m\n";
+    out << "\033[1;30m" << std::string(35, '-') << "\033[0m\n";
     
     int solvedCount = 0;
     for (const auto& island : state.islands) {
@@ -148,11 +181,43 @@ void renderStats(const GameState& state) {
         
         std::string status = isIslandSolved ? "\033[1;32mOK\033[0m" : "\033[1;31mNeed more\033[0m";
         
-        std::cout << std::setw(8) << island.id << " | " 
+        out << std::setw(8) << island.id << " | " 
              << std::setw(8) << current << "/" << std::setw(6) << island.requiredDegree 
              << " | " << status << "\n";
     }
     
-    std::cout << "\n\033[1;33mProgress: " << solvedCount << "/" << state.islands.size() 
+    out << "\n\033[1;33mProgress: " << solvedCount << "/" << state.islands.size() 
          << " islands completed\033[0m\n";
+}
+
+void renderProfile(std::ostream& out) {
+    out << "\n\033[1;36mEngine Profile:\033[0m\n";
+    if (!PROFILING_ENABLED) {
+        out << "\033[1;31mProfiling is compiled out. Rebuild with 'make profile'.\033[0m\n";
+        return;
+    }
+
+    ProfileReport report = collectProfile();
+    out << "\033[1;37m" << std::setw(20) << "Function" << " | " << std::setw(9) << "Calls"
+        << " | " << std::setw(10) << "Mean ns" << " | " << std::setw(10) << "Max ns" << "\033[0m\n";
+    out << "\033[1;30m" << std::string(58, '-') << "\033[0m\n";
+
+    for (int p = 0; p < PROFILE_POINTS; p++) {
+        const ProfileStats& stats = report[p];
+        uint64_t mean = stats.calls ? stats.totalNs / stats.calls : 0;
+        out << std::setw(20) << profilePointName(static_cast<ProfilePoint>(p)) << " | "
+            << std::setw(9) << stats.calls << " | " << std::setw(10) << mean
+            << " | " << std::setw(10) << stats.maxNs << "\n";
+
+        // Latency histogram, one bar per occupied power-of-two bucket
+        uint64_t peak = 0;
+        for (uint64_t count : stats.histogram) peak = std::max(peak, count);
+        for (int b = 0; b < PROFILE_BUCKETS; b++) {
+            if (stats.histogram[b] == 0) continue;
+            int width = static_cast<int>(stats.histogram[b] * 30 / peak);
+            out << std::setw(20) << ("<" + std::to_string(2ULL << b) + "ns") << " | "
+                << "\033[1;33m" << std::string(std::max(width, 1), '#') << "\033[0m "
+                << stats.histogram[b] << "\n";
+        }
+    }
 }
\ No newline at end of file
@@ -1,6 +1,26 @@
 #pragma once
 #include "../model/GameState.h"
+#include <iostream>
 
-void renderMap(const GameState& state);
-void renderConnections(const GameState& state);
-void renderStats(const GameState& state);
+// A window onto the board in board coordinates (x is the row, y the column)
+struct Viewport {
+    int top = 0;
+    int left = 0;
+    int rows = 8;
+    int cols = 8;
+};
+
+// The top-left corner of the board, at most maxRows x maxCols
+Viewport fitViewport(const GameState& state, int maxRows, int maxCols);
+// Scrolls `view`, keeping it over the board
+void panViewport(const GameState& state, Viewport& view, int dRows, int dCols);
+
+// Draws the cells inside `view`. Islands and bridges are looked up through
+// state.tiles, so the cost follows the viewport size, not the board size.
+void renderMap(const GameState& state, std::ostream& out = std::cout,
+               const Viewport& view = Viewport{});
+// With legalOnly, lists just the connections a toggle would currently succeed on
+void renderConnections(const GameState& state, std::ostream& out = std::cout,
+                       bool legalOnly = false);
+void renderStats(const GameState& state, std::ostream& out = std::cout);
+void renderProfile(std::ostream& out = std::cout);
@@ -0,0 +1,479 @@
+#include "SessionServer.h"
+#include "../engine/Moves.h"
+#include "../engine/Snapshot.h"
+#include "../engine/Solver.h"
+#include "../engine/Validators.h"
+#include "../levels/LevelCatalog.h"
+#include "../render/ConsoleRender.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const int MAX_EVENTS = 256;
+const size_t READ_CHUNK = 4096;
+const size_t MAX_LINE = 16384;
+const size_t ARENA_BYTES = 4096;
+// Solver steps one session gets per turn of the event loop
+const int SOLVE_SLICE_STEPS = 256;
+
+volatile std::sig_atomic_t stopRequested = 0;
+// Sessions with a SOLVE in progress; while nonzero the loop polls instead of blocking
+int activeSolves = 0;
+
+void requestStop(int) {
+    stopRequested = 1;
+}
+
+// One connected client. The move history lives in a per-session arena that
+// is dropped wholesale whenever a new level is loaded.
+struct Session {
+    Session(int socketFd, LevelCatalog& levels)
+        : fd(socketFd),
+          catalog(&levels),
+          arena(arenaBuffer, sizeof(arenaBuffer)),
+          history(&arena) {}
+
+    int fd;
+    LevelCatalog* catalog;
+    uint32_t events = EPOLLIN;      // what epoll currently watches for
+    bool closing = false;
+    bool inputDone = false;         // peer shut down its side; no more requests
+    alignas(std::max_align_t) unsigned char arenaBuffer[ARENA_BYTES];
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<MoveRecord> history;
+    std::string input;
+    std::string output;
+    GameState state;
+    std::unique_ptr<Solver> solver;   // set while a SOLVE is running
+};
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+void resetArena(Session& session) {
+    // Move-assigning an empty vector on the same resource hands back the old
+    // buffer before the arena is rewound, so nothing dangles.
+    session.history = std::pmr::vector<MoveRecord>(&session.arena);
+    session.arena.release();
+}
+
+void handleLoad(Session& session, std::istringstream& args) {
+    int id = 0;
+    args >> id;
+    std::shared_ptr<const LevelGraph> level = session.catalog->acquire(id);
+    if (!level) {
+        session.output += session.catalog->contains(id) ? "ERR invalid level\n" : "ERR unknown level\n";
+        return;
+    }
+    loadLevelGraph(session.state, *level);
+    resetArena(session);
+    session.output += "OK " + std::to_string(session.state.connections.size()) + "\n";
+}
+
+void handleToggle(Session& session, std::istringstream& args) {
+    int idx = -1;
+    if (!(args >> idx) || idx < 0 || idx >= static_cast<int>(session.state.connections.size())) {
+        session.output += "ERR invalid connection\n";
+        return;
+    }
+    int previous = session.state.connections[idx].bridges;
+    if (!tryToggleBridge(session.state, idx)) {
+        session.output += "ERR illegal move\n";
+        return;
+    }
+    session.history.push_back({idx, previous});
+    session.output += "OK " + std::to_string(session.state.connections[idx].bridges) + "\n";
+}
+
+void handleUndo(Session& session) {
+    if (session.history.empty()) {
+        session.output += "ERR nothing to undo\n";
+        return;
+    }
+    undoMove(session.state, session.history.back());
+    session.history.pop_back();
+    session.output += "OK\n";
+}
+
+// Largest window a RENDER may ask for, per side
+const int MAX_RENDER_SIDE = 256;
+
+void handleRender(Session& session, std::istringstream& args) {
+    Viewport view;
+    int top, left, rows, cols;
+    if (args >> top >> left >> rows >> cols) {
+        // Keep the window within one screen of the board so that no
+        // coordinate arithmetic downstream can overflow
+        const SpatialIndex& tiles = *session.state.tiles;
+        rows = std::clamp(rows, 1, MAX_RENDER_SIDE);
+        cols = std::clamp(cols, 1, MAX_RENDER_SIDE);
+        view = Viewport{std::clamp(top, tiles.originX - rows, tiles.originX + tiles.extentX),
+                        std::clamp(left, tiles.originY - cols, tiles.originY + tiles.extentY),
+                        rows, cols};
+    }
+    std::ostringstream frame;
+    renderMap(session.state, frame, view);
+    session.output += frame.str();
+    session.output += "END\n";
+}
+
+void handleSnapshot(Session& session) {
+    static const char HEX[] = "0123456789abcdef";
+    std::vector<uint8_t> data = saveSnapshot(session.state);
+    session.output += "OK ";
+    for (uint8_t byte : data) {
+        session.output += HEX[byte >> 4];
+        session.output += HEX[byte & 0xF];
+    }
+    session.output += "\n";
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void handleRestore(Session& session, std::istringstream& args) {
+    std::string hex;
+    args >> hex;
+    std::vector<uint8_t> data;
+    data.reserve(hex.size() / 2);
+    bool valid = hex.size() % 2 == 0;
+    for (size_t i = 0; valid && i < hex.size(); i += 2) {
+        int hi = hexValue(hex[i]);
+        int lo = hexValue(hex[i + 1]);
+        valid = hi >= 0 && lo >= 0;
+        data.push_back(static_cast<uint8_t>((hi << 4) | lo));
+    }
+    if (!valid || !restoreSnapshot(session.state, data)) {
+        session.output += "ERR snapshot does not match level\n";
+        return;
+    }
+    resetArena(session);
+    session.output += "OK\n";
+}
+
+void handleLine(Session& session, const std::string& line) {
+    std::istringstream args(line);
+    std::string command;
+    args >> command;
+
+    if (command == "LOAD") {
+        handleLoad(session, args);
+    } else if (command == "TOGGLE") {
+        handleToggle(session, args);
+    } else if (command == "UNDO") {
+        handleUndo(session);
+    } else if (command == "VALIDATE") {
+        session.output += isSolved(session.state) ? "SOLVED\n" : "UNSOLVED\n";
+    } else if (command == "RENDER") {
+        handleRender(session, args);
+    } else if (command == "SNAPSHOT") {
+        handleSnapshot(session);
+    } else if (command == "RESTORE") {
+        handleRestore(session, args);
+    } else if (command == "SOLVE") {
+        // Runs in slices from the event loop; the reply comes when it ends
+        session.solver = std::make_unique<Solver>(session.state);
+        activeSolves++;
+    } else if (command == "CANCEL") {
+        // A running solve is cancelled before its line gets here
+        session.output += "ERR no solve running\n";
+    } else if (command == "QUIT") {
+        session.output += "BYE\n";
+        session.closing = true;
+    } else {
+        session.output += "ERR unknown command\n";
+    }
+}
+
+// Ends the running solve without a result and puts the board back
+void abandonSolve(Session& session, const char* reply) {
+    session.solver->rewind();
+    session.output += reply;
+    session.solver.reset();
+    activeSolves--;
+}
+
+// While a solve runs, the queued lines are only searched for CANCEL or
+// QUIT; either ends the solve at once. CANCEL is used up doing so, QUIT
+// still runs in its turn after the lines queued before it.
+void checkForCancel(Session& session) {
+    size_t start = 0;
+    size_t newline;
+    while ((newline = session.input.find('\n', start)) != std::string::npos) {
+        std::istringstream line(session.input.substr(start, newline - start));
+        std::string command;
+        line >> command;
+        if (command == "CANCEL" || command == "QUIT") {
+            abandonSolve(session, "ERR cancelled\n");
+            if (command == "CANCEL") session.input.erase(start, newline + 1 - start);
+            return;
+        }
+        start = newline + 1;
+    }
+}
+
+// Handles complete lines; anything after a SOLVE waits until it finishes
+// or is cancelled
+void processInput(Session& session) {
+    if (session.solver) checkForCancel(session);
+    size_t start = 0;
+    size_t newline;
+    while (!session.closing && !session.solver &&
+           (newline = session.input.find('\n', start)) != std::string::npos) {
+        std::string line = session.input.substr(start, newline - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        handleLine(session, line);
+        start = newline + 1;
+    }
+    session.input.erase(0, start);
+
+    // Once the peer has finished sending, answer what is left and hang up
+    if (session.inputDone && !session.closing && !session.solver) {
+        if (!session.input.empty()) {
+            std::string line = session.input;
+            session.input.clear();
+            handleLine(session, line);
+        }
+        session.closing = true;
+    }
+}
+
+// Returns false once the peer has gone away or misbehaved. End of input
+// (the peer shutting down its write side) still gets every reply.
+bool readFromClient(Session& session) {
+    char buffer[READ_CHUNK];
+    while (!session.closing) {
+        ssize_t n = read(session.fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            // Handle lines chunk by chunk so a long burst cannot pile up
+            session.input.append(buffer, static_cast<size_t>(n));
+            processInput(session);
+            if (session.input.size() > MAX_LINE) return false;
+            continue;
+        }
+        if (n == 0) {
+            session.inputDone = true;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        return false;
+    }
+
+    processInput(session);
+    return true;
+}
+
+// Gives a solving session one slice of steps and answers once it is done
+void advanceSolve(Session& session) {
+    Solver& solver = *session.solver;
+    for (int k = 0; k < SOLVE_SLICE_STEPS && !solver.finished(); k++) solver.step();
+    if (!solver.finished()) {
+        if (solver.steps() >= MAX_SOLVE_STEPS) {
+            abandonSolve(session, "ERR gave up\n");
+            processInput(session);
+        }
+        return;
+    }
+
+    if (solver.step().event == SolveEvent::Solved) {
+        for (const MoveRecord& move : solver.appliedMoves()) session.history.push_back(move);
+        session.output += "SOLVED " + std::to_string(solver.steps()) + "\n";
+    } else {
+        solver.rewind();
+        session.output += "ERR no solution\n";
+    }
+    session.solver.reset();
+    activeSolves--;
+    processInput(session);
+}
+
+// Returns false on a hard write error
+bool flushToClient(Session& session) {
+    size_t sent = 0;
+    while (sent < session.output.size()) {
+        ssize_t n = send(session.fd, session.output.data() + sent,
+                         session.output.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    session.output.erase(0, sent);
+    return true;
+}
+
+// Sends what it can; false once the session should be closed
+bool settleSession(Session& session) {
+    if (!flushToClient(session)) return false;
+    return !(session.closing && session.output.empty());
+}
+
+void dropSession(int epollFd, std::unordered_map<int, std::unique_ptr<Session>>& sessions, int fd) {
+    auto it = sessions.find(fd);
+    if (it == sessions.end()) return;
+    if (it->second->solver) activeSolves--;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    sessions.erase(it);
+}
+
+void updateInterest(int epollFd, Session& session) {
+    // A finished peer stays readable forever; stop asking about it
+    uint32_t wanted = (session.inputDone ? 0u : uint32_t(EPOLLIN)) |
+                      (session.output.empty() ? 0u : uint32_t(EPOLLOUT));
+    if (wanted == session.events) return;
+    epoll_event ev{};
+    ev.events = wanted;
+    ev.data.fd = session.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &ev);
+    session.events = wanted;
+}
+
+int openListener(const std::string& socketPath) {
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << socketPath << "\n";
+        return -1;
+    }
+
+    // A socket left behind by an earlier run is replaced; anything else at
+    // the path is not ours to delete
+    struct stat existing;
+    if (lstat(socketPath.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            std::cerr << socketPath << " exists and is not a socket\n";
+            return -1;
+        }
+        unlink(socketPath.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        std::cerr << "socket: " << std::strerror(errno) << "\n";
+        return -1;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1 ||
+        listen(fd, SOMAXCONN) == -1 || !setNonBlocking(fd)) {
+        std::cerr << "listen on " << socketPath << ": " << std::strerror(errno) << "\n";
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+bool runSessionServer(const std::string& socketPath, LevelCatalog& catalog) {
+    int listenFd = openListener(socketPath);
+    if (listenFd == -1) return false;
+
+    int epollFd = epoll_create1(0);
+    if (epollFd == -1) {
+        std::cerr << "epoll_create1: " << std::strerror(errno) << "\n";
+        close(listenFd);
+        return false;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    std::cout << "Serving sessions on " << socketPath << "\n";
+
+    std::unordered_map<int, std::unique_ptr<Session>> sessions;
+    epoll_event events[MAX_EVENTS];
+
+    while (!stopRequested) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, activeSolves > 0 ? 0 : -1);
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            std::cerr << "epoll_wait: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        for (int e = 0; e < ready; e++) {
+            int fd = events[e].data.fd;
+
+            if (fd == listenFd) {
+                int clientFd;
+                while ((clientFd = accept(listenFd, nullptr, nullptr)) != -1) {
+                    if (!setNonBlocking(clientFd)) {
+                        close(clientFd);
+                        continue;
+                    }
+                    epoll_event clientEv{};
+                    clientEv.events = EPOLLIN;
+                    clientEv.data.fd = clientFd;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &clientEv);
+                    sessions[clientFd] = std::make_unique<Session>(clientFd, catalog);
+                }
+                continue;
+            }
+
+            auto it = sessions.find(fd);
+            if (it == sessions.end()) continue;
+            Session& session = *it->second;
+
+            bool alive = !(events[e].events & (EPOLLERR | EPOLLHUP)) ||
+                         (events[e].events & EPOLLIN);
+            if (alive && (events[e].events & EPOLLIN)) alive = readFromClient(session);
+            if (alive) alive = settleSession(session);
+
+            if (!alive) dropSession(epollFd, sessions, fd);
+            else updateInterest(epollFd, session);
+        }
+
+        // Time-slice running solves so one large board cannot stall the rest
+        if (activeSolves > 0) {
+            std::vector<int> done;
+            for (auto& entry : sessions) {
+                Session& session = *entry.second;
+                if (!session.solver) continue;
+                advanceSolve(session);
+                if (settleSession(session)) updateInterest(epollFd, session);
+                else done.push_back(entry.first);
+            }
+            for (int fd : done) dropSession(epollFd, sessions, fd);
+        }
+    }
+
+    for (auto& entry : sessions) close(entry.first);
+    close(epollFd);
+    close(listenFd);
+    unlink(socketPath.c_str());
+    return true;
+}
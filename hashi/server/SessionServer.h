@@ -0,0 +1,37 @@
+#pragma once
+#include "../levels/LevelCatalog.h"
+#include <string>
+
+// Hosts many independent game sessions in one process over a Unix domain
+// socket. Each connected client owns one GameState and talks a line-based
+// protocol, one response per request:
+//
+//   LOAD <level>    -> OK <connection count>    | ERR unknown level
+//                                               | ERR invalid level
+//   TOGGLE <index>  -> OK <bridges>             | ERR invalid connection
+//                                               | ERR illegal move
+//   UNDO            -> OK                       | ERR nothing to undo
+//   VALIDATE        -> SOLVED | UNSOLVED
+//   SOLVE           -> SOLVED <steps>           | ERR no solution | ERR gave up
+//                                               | ERR cancelled
+//   CANCEL          -> (ends a running SOLVE)   | ERR no solve running
+//   RENDER          -> map lines, then END
+//   RENDER t l r c  -> same, for an r x c window with top-left cell (t, l)
+//   SNAPSHOT        -> OK <hex snapshot>
+//   RESTORE <hex>   -> OK | ERR snapshot does not match level
+//   QUIT            -> BYE (connection closed)
+//
+// Any other command gets ERR unknown command. "invalid level" means the
+// level exists but its file describes a malformed graph. A snapshot is the
+// session's bridge counts (see engine/Snapshot.h) and restores only into
+// the same level.
+//
+// SOLVE runs the resumable solver a slice of steps per turn of the event
+// loop, so long solves share the thread with every other session; later
+// requests from that client wait for its answer. A solve gives up after a
+// fixed step budget, and a CANCEL or QUIT sent meanwhile ends it at once;
+// either way the board is put back as it was. LOAD takes its levels from
+// `catalog`, so sessions on the same level share one built graph. Returns
+// false if the socket could not be set up; otherwise runs until SIGINT or
+// SIGTERM and then shuts down cleanly.
+bool runSessionServer(const std::string& socketPath, LevelCatalog& catalog);
@@ -0,0 +1,131 @@
+// Heap allocation check for the engine's per-move paths.
+//
+// Usage: alloccheck [rounds]
+//
+// Global operator new is replaced with a counting version. A generated
+// board is loaded and played for one warm-up round, which lets the scratch
+// arena and any lazily sized buffers reach their working size. Counting then
+// starts, and further rounds of toggles, undos and the validate and
+// legal-move queries run. Any allocation in those rounds is reported per
+// operation and makes the exit status nonzero.
+#include "BoardGenerator.h"
+#include "../engine/GameUtils.h"
+#include "../engine/Moves.h"
+#include "../engine/SolveTracker.h"
+#include "../engine/Validators.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+bool counting = false;
+long allocations = 0;
+
+void* countedAlloc(std::size_t bytes) {
+    if (counting) allocations++;
+    if (void* p = std::malloc(bytes ? bytes : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(std::size_t bytes, std::align_val_t alignment) {
+    if (counting) allocations++;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t size = (bytes + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, size ? size : align)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t bytes) { return countedAlloc(bytes); }
+void* operator new[](std::size_t bytes) { return countedAlloc(bytes); }
+void* operator new(std::size_t bytes, std::align_val_t alignment) { return countedAlignedAlloc(bytes, alignment); }
+void* operator new[](std::size_t bytes, std::align_val_t alignment) { return countedAlignedAlloc(bytes, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+enum Operation { TOGGLE, UNDO, LEGAL, ADDABLE, CROSSINGS, CONNECTIVITY, REACHABLE, DEGREE, SOLVED,
+                 SOLVED_FULL, DEAD_END, OPERATION_COUNT };
+
+const char* const OPERATION_NAMES[OPERATION_COUNT] = {
+    "tryToggleBridge", "undoMove", "isLegalToggle", "forEachAddableConnection", "validateCrossings",
+    "validateConnectivity", "isReachable", "currentDegree", "isSolved", "isSolvedFull", "isDeadEnd"};
+
+long counts[OPERATION_COUNT] = {};
+
+// Query results land here so the calls cannot be optimised away
+volatile bool sink = false;
+
+// Runs one operation, charging whatever it allocates to that operation
+template <typename Call>
+void measured(Operation op, Call&& call) {
+    long before = allocations;
+    call();
+    counts[op] += allocations - before;
+}
+
+// One round: a burst of random toggles, each followed by every query, then
+// all but the first 32 accepted ones undone
+void playRound(GameState& state, BoardRandom& random) {
+    int count = static_cast<int>(state.connections.size());
+    int islands = static_cast<int>(state.islands.size());
+    MoveRecord history[64];
+    int made = 0;
+    for (int move = 0; move < 64; move++) {
+        int c = random.below(count);
+        int previous = state.connections[c].bridges;
+        bool accepted = false;
+        measured(LEGAL, [&] { sink = isLegalToggle(state, c); });
+        measured(TOGGLE, [&] { accepted = tryToggleBridge(state, c); });
+        if (accepted) history[made++] = {c, previous};
+
+        int addable = 0;
+        measured(ADDABLE, [&] { forEachAddableConnection(state, [&](int) { addable++; }); });
+        sink = addable > 0;
+        int a = state.islands[random.below(islands)].id;
+        int b = state.islands[random.below(islands)].id;
+        measured(CROSSINGS, [&] { sink = validateCrossings(state); });
+        measured(CONNECTIVITY, [&] { sink = validateConnectivity(state); });
+        measured(REACHABLE, [&] { sink = isReachable(state, a, b); });
+        measured(DEGREE, [&] { sink = currentDegree(state, a) > 0; });
+        measured(SOLVED, [&] { sink = isSolved(state); });
+        measured(SOLVED_FULL, [&] { sink = isSolvedFull(state); });
+        measured(DEAD_END, [&] { sink = isDeadEnd(state); });
+    }
+    while (made > 32) measured(UNDO, [&] { undoMove(state, history[--made]); });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 100;
+    if (rounds < 1) rounds = 1;
+    BoardRandom random{20240601};
+
+    GeneratedBoard generated;
+    while (!generateBoard(random, 32, 200, generated)) {}
+    GameState state;
+    loadLevel(state, generated.islands);
+
+    playRound(state, random);
+    counting = true;
+    for (int round = 0; round < rounds; round++) playRound(state, random);
+    counting = false;
+
+    long total = 0;
+    for (int op = 0; op < OPERATION_COUNT; op++) {
+        std::printf("  %-26s %8ld\n", OPERATION_NAMES[op], counts[op]);
+        total += counts[op];
+    }
+    std::printf("%ld allocations over %d rounds\n", total, rounds);
+    return total == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#pragma once
+// Seeded generator of solvable boards, shared by the benchmark tools.
+//
+// Lays out islands, bridges a random non-crossing spanning forest plus some
+// extra bridges, and keeps the largest bridged group with its degrees as the
+// puzzle. Island ids follow reading order (row, then column), like the
+// built-in levels. The same seed gives the same boards on every platform.
+#include "../engine/GraphBuilder.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <set>
+#include <vector>
+
+// Small LCG so boards do not depend on the standard library's
+// distribution or shuffle implementations
+struct BoardRandom {
+    uint64_t state;
+    uint32_t next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(state >> 33);
+    }
+    int below(int n) { return static_cast<int>(next() % static_cast<uint32_t>(n)); }
+};
+
+struct GeneratedBoard {
+    std::vector<Island> islands;
+    std::vector<Connection> solution;   // bridged connections of one solution
+};
+
+inline int boardRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+// Returns false if the bridged islands fall apart into small groups
+inline bool generateBoard(BoardRandom& random, int size, int islandCount, GeneratedBoard& out) {
+    std::set<std::pair<int, int>> used;
+    while (static_cast<int>(used.size()) < islandCount)
+        used.insert({random.below(size), random.below(size)});
+    std::vector<Island> islands;
+    for (const auto& cell : used)   // std::set orders cells row by row
+        islands.push_back({static_cast<int>(islands.size()) + 1, cell.first, cell.second, 8});
+
+    GameState layout;
+    loadLevel(layout, islands);
+    std::vector<int> order(layout.connections.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (int i = static_cast<int>(order.size()) - 1; i > 0; i--)
+        std::swap(order[i], order[random.below(i + 1)]);
+
+    std::vector<int> bridges(order.size(), 0);
+    auto crossesBridge = [&](int c) {
+        for (int k = layout.index->conflictStart[c]; k < layout.index->conflictStart[c + 1]; k++)
+            if (bridges[layout.index->conflictList[k]] > 0) return true;
+        return false;
+    };
+
+    std::vector<int> parent(islands.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    for (int c : order) {
+        int a = boardRoot(parent, layout.index->ends[c].a);
+        int b = boardRoot(parent, layout.index->ends[c].b);
+        if (a == b || crossesBridge(c)) continue;
+        parent[a] = b;
+        bridges[c] = 1;
+    }
+
+    for (int c : order) {
+        if (bridges[c] == 1 && random.below(3) == 0) bridges[c] = 2;
+        else if (bridges[c] == 0 && random.below(4) == 0 && !crossesBridge(c)) bridges[c] = 1 + random.below(2);
+    }
+
+    for (auto& island : islands) island.requiredDegree = 0;
+    for (std::size_t c = 0; c < bridges.size(); c++) {
+        islands[layout.index->ends[c].a].requiredDegree += bridges[c];
+        islands[layout.index->ends[c].b].requiredDegree += bridges[c];
+    }
+
+    // Crossings can leave a few islands unreachable. Keeping only the
+    // largest bridged group still gives a solvable board: removing an
+    // island never puts it under one of the remaining bridges.
+    std::vector<int> groupSize(islands.size(), 0);
+    for (std::size_t i = 0; i < islands.size(); i++) groupSize[boardRoot(parent, static_cast<int>(i))]++;
+    int largest = static_cast<int>(std::max_element(groupSize.begin(), groupSize.end()) - groupSize.begin());
+    if (groupSize[largest] < islandCount / 2) return false;
+
+    std::vector<int> newId(islands.size(), 0);
+    out.islands.clear();
+    for (std::size_t i = 0; i < islands.size(); i++) {
+        if (boardRoot(parent, static_cast<int>(i)) != largest) continue;
+        Island island = islands[i];
+        island.id = static_cast<int>(out.islands.size()) + 1;
+        newId[i] = island.id;
+        out.islands.push_back(island);
+    }
+
+    out.solution.clear();
+    for (std::size_t c = 0; c < bridges.size(); c++) {
+        if (bridges[c] == 0) continue;
+        const Connection& conn = layout.connections[c];
+        out.solution.push_back({newId[layout.index->ends[c].a], newId[layout.index->ends[c].b],
+                                conn.orientation, bridges[c]});
+    }
+    return true;
+}
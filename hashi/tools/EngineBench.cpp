@@ -0,0 +1,265 @@
+// Regression and timing harness: the original single-file engine
+// (main_old.cpp) against the modular engine.
+//
+// Usage: enginebench [boards per size] [moves per board] [seed]
+//
+// Each board is loaded into both engines. The harness then plays the same
+// seeded sequence of toggles on both and checks after every move that they
+// agree: the toggle's legality, the bridge count, the endpoint degrees, the
+// crossing check and the solved verdict. Moves are mostly steered towards
+// the generator's solution, so solved positions come up as well as rejected
+// ones. On larger boards stray bridges soon block the steered ones, so every
+// second board first steers straight to within a few toggles of the
+// solution (these moves are compared too, but do not count against the
+// budget) before the mixed moves start. Any disagreement is printed and
+// makes the exit status nonzero.
+//
+// The legacy bridgesCross assumes islandA lies above or left of islandB,
+// which holds when island ids follow reading order. The built-in level and
+// the generated boards both keep that order.
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// The legacy renderer copies islands into locals it only fills when the ids
+// match, which -O2 flags as maybe-uninitialized; the file is kept as it was
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace legacy {
+#define main legacyMain
+#include "../main_old.cpp"
+#undef main
+}
+#pragma GCC diagnostic pop
+
+#include "BoardGenerator.h"
+#include "../engine/Moves.h"
+#include "../engine/Validators.h"
+#include <chrono>
+#include <cstdlib>
+
+namespace {
+
+struct Corpus {
+    int size;       // board is size x size, 0 for the legacy built-in level
+    int islands;
+};
+
+// The legacy move check is quadratic in connections, which bounds the sizes
+const Corpus CORPUS[] = {{0, 0}, {8, 14}, {16, 50}, {24, 110}, {32, 200}};
+
+enum Operation { LOAD, TOGGLE, CROSSINGS, DEGREE, SOLVED, OPERATION_COUNT };
+
+const char* const OPERATION_NAMES[OPERATION_COUNT] = {
+    "load", "tryToggleBridge", "validateCrossings", "currentDegree", "isSolved"};
+
+struct Timings {
+    long calls[OPERATION_COUNT] = {};
+    double legacyNs[OPERATION_COUNT] = {};
+    double modularNs[OPERATION_COUNT] = {};
+};
+
+const int MAX_REPORTED_MISMATCHES = 10;
+
+// Toggles left undone when a near-solution run switches to mixed moves
+const int NEAR_SOLUTION_TOGGLES = 4;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Times one call of each engine's version of an operation
+template <typename Legacy, typename Modular>
+void timed(Timings& timings, Operation op, Legacy&& legacyCall, Modular&& modularCall) {
+    auto start = Clock::now();
+    legacyCall();
+    timings.legacyNs[op] += elapsedNs(start);
+    start = Clock::now();
+    modularCall();
+    timings.modularNs[op] += elapsedNs(start);
+    timings.calls[op]++;
+}
+
+bool sameConnections(const legacy::GameState& old, const GameState& state) {
+    if (old.connections.size() != state.connections.size()) return false;
+    for (std::size_t i = 0; i < old.connections.size(); i++) {
+        const legacy::Connection& a = old.connections[i];
+        const Connection& b = state.connections[i];
+        bool sameOrientation = (a.orientation == legacy::Orientation::HORIZONTAL) ==
+                               (b.orientation == Orientation::HORIZONTAL);
+        if (a.islandA != b.islandA || a.islandB != b.islandB || !sameOrientation) return false;
+    }
+    return true;
+}
+
+struct BoardRun {
+    int moves = 0;
+    int rejected = 0;
+    int solvedPositions = 0;
+    int mismatches = 0;
+};
+
+void reportMismatch(BoardRun& run, const std::string& board, int move, const std::string& what) {
+    if (run.mismatches++ < MAX_REPORTED_MISMATCHES)
+        std::cout << "MISMATCH " << board << " move " << move << ": " << what << "\n";
+}
+
+BoardRun playBoard(const std::string& board, const std::vector<Island>& islands,
+                   const std::vector<Connection>& solution, BoardRandom& random,
+                   int moves, bool nearSolution, Timings& timings) {
+    BoardRun run;
+    std::vector<legacy::Island> oldIslands;
+    for (const auto& island : islands)
+        oldIslands.push_back({island.id, island.x, island.y, island.requiredDegree});
+
+    legacy::GameState old;
+    GameState state;
+    timed(timings, LOAD,
+          [&] { old = {oldIslands, legacy::computeConnections(oldIslands)}; },
+          [&] { loadLevel(state, islands); });
+    if (!sameConnections(old, state)) {
+        reportMismatch(run, board, 0, "connection lists differ");
+        return run;
+    }
+
+    // Bridge count of the known solution on each connection
+    std::vector<int> target(state.connections.size(), 0);
+    for (const auto& bridge : solution) {
+        for (std::size_t c = 0; c < state.connections.size(); c++) {
+            const Connection& conn = state.connections[c];
+            if (conn.islandA == bridge.islandA && conn.islandB == bridge.islandB) target[c] = bridge.bridges;
+        }
+    }
+
+    int count = static_cast<int>(state.connections.size());
+    std::vector<int> off;
+    int mixed = 0;
+    bool approaching = nearSolution;
+    for (int move = 1; mixed < moves && count > 0; move++) {
+        // Toggles cycle 0 -> 1 -> 2 -> 0, so each off connection needs one or two
+        off.clear();
+        int togglesLeft = 0;
+        for (int c = 0; c < count; c++) {
+            if (state.connections[c].bridges == target[c]) continue;
+            off.push_back(c);
+            togglesLeft += (target[c] - state.connections[c].bridges + 3) % 3;
+        }
+        // Approaching moves all head for the solution; after that three in
+        // four do, and the rest are anywhere
+        approaching = approaching && togglesLeft > NEAR_SOLUTION_TOGGLES;
+        mixed += !approaching;
+        int c = (!off.empty() && (approaching || random.below(4) != 0))
+                    ? off[random.below(static_cast<int>(off.size()))]
+                    : random.below(count);
+
+        bool oldAccepted = false, accepted = false;
+        timed(timings, TOGGLE,
+              [&] { oldAccepted = legacy::tryToggleBridge(old, c); },
+              [&] { accepted = tryToggleBridge(state, c); });
+        run.moves++;
+        run.rejected += !accepted;
+        std::string where = "connection " + std::to_string(c);
+        if (oldAccepted != accepted)
+            reportMismatch(run, board, move, where + (accepted ? " accepted" : " rejected") +
+                                             " by the modular engine only");
+        if (old.connections[c].bridges != state.connections[c].bridges)
+            reportMismatch(run, board, move, where + " bridge counts differ");
+
+        bool oldCrossingFree = false, crossingFree = false;
+        timed(timings, CROSSINGS,
+              [&] { oldCrossingFree = legacy::validateCrossings(old); },
+              [&] { crossingFree = validateCrossings(state); });
+        if (oldCrossingFree != crossingFree || !crossingFree)
+            reportMismatch(run, board, move, "crossing checks disagree or a crossing was allowed");
+
+        for (int id : {state.connections[c].islandA, state.connections[c].islandB}) {
+            int oldDegree = 0, degree = 0;
+            timed(timings, DEGREE,
+                  [&] { oldDegree = legacy::currentDegree(old, id); },
+                  [&] { degree = currentDegree(state, id); });
+            if (oldDegree != degree)
+                reportMismatch(run, board, move, "island " + std::to_string(id) + " degrees differ");
+        }
+
+        bool oldSolved = false, solved = false;
+        timed(timings, SOLVED,
+              [&] { oldSolved = legacy::isSolved(old); },
+              [&] { solved = isSolved(state); });
+        if (oldSolved != solved || solved != isSolvedFull(state))
+            reportMismatch(run, board, move, "solved verdicts differ");
+        if (solved) {
+            run.solvedPositions++;
+            break;
+        }
+    }
+    return run;
+}
+
+void printTimings(const Timings& timings) {
+    std::cout << std::fixed << std::setprecision(1);
+    for (int op = 0; op < OPERATION_COUNT; op++) {
+        if (timings.calls[op] == 0) continue;
+        double legacyNs = timings.legacyNs[op] / timings.calls[op];
+        double modularNs = timings.modularNs[op] / timings.calls[op];
+        std::cout << "  " << std::setw(18) << std::left << OPERATION_NAMES[op] << std::right
+                  << std::setw(9) << timings.calls[op]
+                  << " | " << std::setw(12) << legacyNs << std::setw(12) << modularNs
+                  << " | " << std::setw(8) << (modularNs > 0 ? legacyNs / modularNs : 0) << "x\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int perSize = argc > 1 ? std::atoi(argv[1]) : 3;
+    int moves = argc > 2 ? std::atoi(argv[2]) : 200;
+    BoardRandom random{argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20240601ULL};
+
+    int mismatches = 0;
+    for (const Corpus& spec : CORPUS) {
+        Timings timings;
+        BoardRun total;
+        int boards = 0;
+        std::string name = spec.size == 0 ? "level 1"
+                                           : std::to_string(spec.size) + "x" + std::to_string(spec.size);
+
+        for (int n = 0; n < perSize; n++) {
+            GeneratedBoard generated;
+            if (spec.size == 0) {
+                // The legacy level carries no solution; moves stay random
+                for (const auto& island : legacy::createLevel())
+                    generated.islands.push_back({island.id, island.x, island.y, island.requiredDegree});
+            } else {
+                while (!generateBoard(random, spec.size, spec.islands, generated)) {}
+            }
+            BoardRun run = playBoard(name + " #" + std::to_string(n + 1), generated.islands,
+                                     generated.solution, random, moves, n % 2 == 1, timings);
+            total.moves += run.moves;
+            total.rejected += run.rejected;
+            total.solvedPositions += run.solvedPositions;
+            total.mismatches += run.mismatches;
+            boards++;
+        }
+
+        std::cout << name << ": " << boards << " boards, " << total.moves << " moves ("
+                  << total.rejected << " rejected), " << total.solvedPositions << " solved, "
+                  << total.mismatches << " mismatches\n";
+        std::cout << "  " << std::setw(18) << std::left << "operation" << std::right
+                  << std::setw(9) << "calls" << " | " << std::setw(12) << "legacy ns"
+                  << std::setw(12) << "modular ns" << " | " << std::setw(9) << "speedup" << "\n";
+        printTimings(timings);
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << "\n";
+        mismatches += total.mismatches;
+    }
+
+    std::cout << (mismatches == 0 ? "engines agree on every move\n"
+                                  : std::to_string(mismatches) + " mismatches\n");
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// Drives a running session server with many concurrent clients.
+//
+// Usage: loadclient <socket path> [sessions] [rounds]
+//
+// Every round sends one command to each session and then collects all the
+// replies, so the server always has `sessions` requests in flight.
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct ClientConn {
+    int fd = -1;
+    int connectionCount = 0;
+    std::string buffer;
+};
+
+int connectTo(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) return -1;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendLine(ClientConn& conn, const std::string& line) {
+    std::string data = line + "\n";
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(conn.fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool readLine(ClientConn& conn, std::string& line) {
+    size_t newline;
+    while ((newline = conn.buffer.find('\n')) == std::string::npos) {
+        char chunk[4096];
+        ssize_t n = read(conn.fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        conn.buffer.append(chunk, static_cast<size_t>(n));
+    }
+    line = conn.buffer.substr(0, newline);
+    conn.buffer.erase(0, newline + 1);
+    return true;
+}
+
+// RENDER replies span several lines terminated by END
+bool readReply(ClientConn& conn, const std::string& command, std::string& first) {
+    if (!readLine(conn, first)) return false;
+    if (command != "RENDER") return true;
+    std::string line = first;
+    while (line != "END") {
+        if (!readLine(conn, line)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <socket path> [sessions] [rounds]\n";
+        return 1;
+    }
+    std::string path = argv[1];
+    int sessionCount = argc > 2 ? std::atoi(argv[2]) : 500;
+    int rounds = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    std::vector<ClientConn> conns(sessionCount);
+    for (auto& conn : conns) {
+        conn.fd = connectTo(path);
+        if (conn.fd == -1) {
+            std::cerr << "connect " << path << ": " << std::strerror(errno) << "\n";
+            return 1;
+        }
+    }
+
+    std::string reply;
+    for (auto& conn : conns) {
+        if (!sendLine(conn, "LOAD 1") || !readLine(conn, reply) || reply.rfind("OK ", 0) != 0) {
+            std::cerr << "LOAD failed: " << reply << "\n";
+            return 1;
+        }
+        conn.connectionCount = std::atoi(reply.c_str() + 3);
+    }
+
+    std::mt19937 rng(12345);
+    long long commands = 0;
+    long long errors = 0;
+    double worstRoundMs = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < rounds; round++) {
+        auto roundStart = std::chrono::steady_clock::now();
+        std::vector<std::string> sent(conns.size());
+
+        for (size_t i = 0; i < conns.size(); i++) {
+            std::string command;
+            if (round % 50 == 49) command = "RENDER";
+            else if (round % 10 == 9) command = "VALIDATE";
+            else if (round % 7 == 6) command = "UNDO";
+            else command = "TOGGLE " + std::to_string(rng() % conns[i].connectionCount);
+
+            if (!sendLine(conns[i], command)) {
+                std::cerr << "send failed\n";
+                return 1;
+            }
+            sent[i] = command;
+        }
+
+        for (size_t i = 0; i < conns.size(); i++) {
+            if (!readReply(conns[i], sent[i], reply)) {
+                std::cerr << "read failed\n";
+                return 1;
+            }
+            if (reply.rfind("ERR", 0) == 0) errors++;
+            commands++;
+        }
+
+        double roundMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - roundStart).count();
+        if (roundMs > worstRoundMs) worstRoundMs = roundMs;
+    }
+
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (auto& conn : conns) {
+        sendLine(conn, "QUIT");
+        close(conn.fd);
+    }
+
+    std::cout << "Sessions:        " << sessionCount << "\n";
+    std::cout << "Commands:        " << commands << " (" << errors << " rejected)\n";
+    std::cout << "Elapsed:         " << seconds << " s\n";
+    std::cout << "Throughput:      " << (seconds > 0 ? commands / seconds : 0) << " commands/s\n";
+    std::cout << "Mean round trip: " << (rounds > 0 ? seconds * 1000.0 / rounds : 0) << " ms per round\n";
+    std::cout << "Worst round:     " << worstRoundMs << " ms\n";
+    return 0;
+}
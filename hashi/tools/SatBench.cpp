@@ -0,0 +1,94 @@
+// Head-to-head benchmark of the search Solver and the CNF/CDCL engine on a
+// fixed corpus of generated, solvable boards.
+//
+// Usage: satbench [boards per size] [search step limit]
+//
+// The search gives up ("limit") after the step limit; a "FAIL" from either
+// engine means it answered wrongly and makes the exit status nonzero.
+//
+// Boards come from the seeded generator in BoardGenerator.h, so the same
+// corpus is used on every run and platform.
+#include "BoardGenerator.h"
+#include "../engine/SatEncoding.h"
+#include "../engine/Solver.h"
+#include "../engine/Validators.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+struct Corpus {
+    int size;       // board is size x size
+    int islands;
+};
+
+const Corpus CORPUS[] = {{10, 25}, {20, 100}, {32, 250}, {48, 560}, {64, 1000}};
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int perSize = argc > 1 ? std::atoi(argv[1]) : 3;
+    long stepLimit = argc > 2 ? std::atol(argv[2]) : 1000000;
+
+    std::cout << std::setw(7) << "board" << std::setw(8) << "islands" << std::setw(7) << "conns"
+              << " | " << std::setw(10) << "search ms" << std::setw(10) << "steps" << std::setw(8) << "result"
+              << " | " << std::setw(10) << "sat ms" << std::setw(8) << "rounds" << std::setw(10) << "conflicts"
+              << std::setw(8) << "result" << "\n";
+    std::cout << std::string(95, '-') << "\n";
+
+    double searchTotal = 0, satTotal = 0;
+    int searchSolved = 0, satSolved = 0, boards = 0;
+    int wrong = 0;   // every board is solvable, so a failed answer is a bug
+    BoardRandom random{20240601};
+    for (const Corpus& spec : CORPUS) {
+        for (int n = 0; n < perSize; n++) {
+            GeneratedBoard generated;
+            while (!generateBoard(random, spec.size, spec.islands, generated)) {}
+            const std::vector<Island>& islands = generated.islands;
+
+            GameState searchState;
+            loadLevel(searchState, islands);
+            GameState satState;
+            loadLevel(satState, islands);
+            boards++;
+
+            auto start = std::chrono::steady_clock::now();
+            Solver solver(searchState);
+            SolveStep step{SolveEvent::Failed, -1, 0};
+            while (!solver.finished() && solver.steps() < stepLimit) step = solver.step();
+            double searchMs = elapsedMs(start);
+            bool searchOk = solver.finished() && step.event == SolveEvent::Solved && isSolvedFull(searchState);
+
+            start = std::chrono::steady_clock::now();
+            SatStats stats;
+            bool satOk = solveWithSat(satState, &stats) && isSolvedFull(satState);
+            double satMs = elapsedMs(start);
+
+            searchTotal += searchMs;
+            satTotal += satMs;
+            searchSolved += searchOk;
+            satSolved += satOk;
+            wrong += (!searchOk && solver.finished()) + !satOk;
+            std::string board = std::to_string(spec.size) + "x" + std::to_string(spec.size);
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(7) << board << std::setw(8) << islands.size()
+                      << std::setw(7) << searchState.connections.size()
+                      << " | " << std::setw(10) << searchMs << std::setw(10) << solver.steps()
+                      << std::setw(8) << (searchOk ? "ok" : solver.finished() ? "FAIL" : "limit")
+                      << " | " << std::setw(10) << satMs << std::setw(8) << stats.rounds
+                      << std::setw(10) << stats.conflicts << std::setw(8) << (satOk ? "ok" : "FAIL") << "\n";
+        }
+    }
+
+    std::cout << std::string(95, '-') << "\n";
+    std::cout << "search: " << searchSolved << "/" << boards << " solved, " << searchTotal << " ms total\n";
+    std::cout << "sat:    " << satSolved << "/" << boards << " solved, " << satTotal << " ms total\n";
+    return wrong == 0 ? 0 : 1;
+}
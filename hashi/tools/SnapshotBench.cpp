@@ -0,0 +1,104 @@
+// Size and latency of level records and session snapshots.
+//
+// Usage: snapbench [restores per board]
+//
+// Each board gets a mix of bridges from random toggles, then is saved and
+// restored; a restore that does not reproduce the bridge counts makes the
+// exit status nonzero. The largest board is a full 64x64 lattice of
+// islands, the densest level that still fits the 64x64 bitboard graph builder.
+#include "BoardGenerator.h"
+#include "../engine/Moves.h"
+#include "../engine/Snapshot.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Corpus {
+    int size;       // board is size x size
+    int islands;    // 0 for a full lattice
+};
+
+const Corpus CORPUS[] = {{16, 50}, {32, 250}, {64, 1000}, {64, 0}};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+std::vector<Island> lattice(int size) {
+    std::vector<Island> islands;
+    for (int x = 0; x < size; x++)
+        for (int y = 0; y < size; y++)
+            islands.push_back({static_cast<int>(islands.size()) + 1, x, y, 8});
+    return islands;
+}
+
+bool sameBridges(const GameState& a, const GameState& b) {
+    if (a.connections.size() != b.connections.size()) return false;
+    for (std::size_t c = 0; c < a.connections.size(); c++)
+        if (a.connections[c].bridges != b.connections[c].bridges) return false;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int restores = argc > 1 ? std::atoi(argv[1]) : 1000;
+    if (restores < 1) restores = 1;
+    BoardRandom random{20240601};
+
+    std::cout << std::setw(7) << "board" << std::setw(8) << "islands" << std::setw(7) << "conns"
+              << " | " << std::setw(10) << "level B" << std::setw(14) << "level load us"
+              << " | " << std::setw(10) << "snap B" << std::setw(10) << "save us" << std::setw(12) << "restore us"
+              << "\n";
+    std::cout << std::string(88, '-') << "\n";
+
+    int failures = 0;
+    for (const Corpus& spec : CORPUS) {
+        std::vector<Island> islands;
+        if (spec.islands == 0) {
+            islands = lattice(spec.size);
+        } else {
+            GeneratedBoard generated;
+            while (!generateBoard(random, spec.size, spec.islands, generated)) {}
+            islands = generated.islands;
+        }
+
+        GameState state;
+        loadLevel(state, islands);
+        int count = static_cast<int>(state.connections.size());
+        for (int n = 0; n < 2 * count; n++) tryToggleBridge(state, random.below(count));
+
+        std::vector<uint8_t> level = saveLevelRecord(state);
+        GameState copy;
+        auto start = Clock::now();
+        bool loaded = loadLevelRecord(copy, level);
+        double levelUs = elapsedUs(start);
+
+        start = Clock::now();
+        std::vector<uint8_t> snapshot;
+        for (int n = 0; n < restores; n++) snapshot = saveSnapshot(state);
+        double saveUs = elapsedUs(start) / restores;
+
+        start = Clock::now();
+        bool restored = loaded;
+        for (int n = 0; n < restores && restored; n++) restored = restoreSnapshot(copy, snapshot);
+        double restoreUs = elapsedUs(start) / restores;
+
+        bool ok = restored && sameBridges(state, copy);
+        failures += !ok;
+        std::string board = std::to_string(spec.size) + "x" + std::to_string(spec.size);
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << board << std::setw(8) << islands.size() << std::setw(7) << count
+                  << " | " << std::setw(10) << level.size() << std::setw(14) << levelUs
+                  << " | " << std::setw(10) << snapshot.size() << std::setw(10) << saveUs
+                  << std::setw(12) << restoreUs << (ok ? "" : "  FAIL") << "\n";
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -1,80 +1,255 @@
 #include "ConsoleUI.h"
-#include "../render/ConsoleRender.h"
-#include "../engine/Moves.h"
 #include "../engine/Validators.h"
-#include <iostream>
-#include <string>
+#include "../engine/Snapshot.h"
+#include "../engine/Solver.h"
+#include <algorithm>
+#include <poll.h>
+#include <unistd.h>
 
-void clearScreen() {
-    std::cout << "\033[2J\033[H";
+const char* SAVE_FILE = "hashi.sav";
+
+void clearScreen(std::ostream& out) {
+    out << "\033[2J\033[H";
 }
 
-void printMenu() {
-    std::cout << "\n\033[1;32m=== HASHIWOKAKERO CONSOLE GAME ===\033[0m\n";
-    std::cout << "\n\033[1;33mCommands:\033[0m\n";
-    std::cout << "  [number] - Toggle bridge connection (0, 1, or 2 bridges)\n";
-    std::cout << "  'm'      - Show this menu\n";
-    std::cout << "  'c'      - Show all connections\n";
-    std::cout << "  's'      - Show game statistics\n";
-    std::cout << "  'q'      - Quit game\n";
-    std::cout << "\n\033[1;36mGoal:\033[0m Connect all islands with bridges so that each\n";
-    std::cout << "      island has exactly the number of bridges shown.\\n";
+void printMenu(std::ostream& out) {
+    out << "\n\033[1;32m=== HASHIWOKAKERO CONSOLE GAME ===\033[0m\n";
+    out << "\n\033[1;33mCommands:\033[0m\n";
+    out << "  [number] - Toggle bridge connection (0, 1, or 2 bridges)\n";
+    out << "  'u'      - Undo last move\n";
+    out << "  'm'      - Show this menu\n";
+    out << "  'c'      - Show all connections\n";
+    out << "  'l'      - Show only legal moves\n";
+    out << "  's'      - Show game statistics\n";
+    out << "  'p'      - Show engine profile\n";
+    out << "  'w'      - Watch the solver finish the puzzle ('p' pauses, 'q' stops)\n";
+    out << "  arrows   - Scroll the map (or 'up', 'down', 'left', 'right')\n";
+    out << "  'save'   - Save progress to " << SAVE_FILE << "\n";
+    out << "  'load'   - Restore progress from " << SAVE_FILE << "\n";
+    out << "  'q'      - Quit game\n";
+    out << "\n\033[1;36mGoal:\033[0m Connect all islands with bridges so that each\n";
+    out << "      island has exactly the number of bridges shown.\n";
 }
 
-void runConsoleGame(GameState& state) {
-    clearScreen();
-    printMenu();
-    
-    std::string input;
+bool renderTurn(ConsoleSession& session) {
+    std::ostream& out = *session.out;
+
+    // Display current game state
+    renderMap(*session.state, out, session.view);
+
+    // Check if solved
+    if (isSolved(*session.state)) {
+        out << "\n\033[1;32m🎉 CONGRATULATIONS! PUZZLE SOLVED! 🎉\033[0m\n";
+        out << "\033[1;33mAll islands have the correct number of bridges!\033[0m\n";
+        return true;
+    }
+
+    // Warn once, on the turn the position stops being finishable
+    bool deadEnd = isDeadEnd(*session.state);
+    bool entered = deadEnd && !session.deadEnd;
+    session.deadEnd = deadEnd;
+    if (entered) {
+        const GameState& state = *session.state;
+        out << "\n\033[1;31mDead end: ";
+        if (state.progress.shortIslands > 0) {
+            out << "island(s)";
+            for (size_t i = 0; i < state.islands.size(); i++)
+                if (state.progress.shortOfCapacity[i]) out << " " << state.islands[i].id;
+            out << " can no longer reach their count.";
+        } else {
+            out << "a finished group of islands is cut off from the rest.";
+        }
+        out << " Remove bridges to continue.\033[0m\n";
+    }
+    return false;
+}
+
+// Waits up to timeoutMs (-1: forever) for a line on fd and returns its first
+// character, or 0 if nothing arrived. End of input reads as 'q'.
+char readControl(int fd, int timeoutMs) {
+    pollfd pfd{fd, POLLIN, 0};
+    if (poll(&pfd, 1, timeoutMs) <= 0) return 0;
+    char buffer[64];
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n <= 0) return 'q';
+    for (ssize_t i = 0; i < n; i++) {
+        if (buffer[i] != ' ' && buffer[i] != '\n' && buffer[i] != '\r') return buffer[i];
+    }
+    return 0;
+}
+
+void describeStep(const GameState& state, const SolveStep& step, int count, std::ostream& out) {
+    const char* color = "\033[1;32m";
+    const char* what = "Deduced";
+    if (step.event == SolveEvent::Guessed) {
+        color = "\033[1;33m";
+        what = "Guessed";
+    } else if (step.event == SolveEvent::Backtracked) {
+        color = "\033[1;31m";
+        what = "Backtracked";
+    }
+    const Connection& conn = state.connections[step.connectionIndex];
+    out << color << "Step " << count << ": " << what << " - connection " << step.connectionIndex
+        << " (" << conn.islandA << " <-> " << conn.islandB << ") now has " << step.bridges
+        << " bridge(s)\033[0m\n";
+}
+
+// Animates the solver from the current position, one deduction per frame.
+// Solver moves join the undo history; stopping, failing or running past
+// MAX_SOLVE_STEPS restores the board.
+void watchSolve(ConsoleSession& session) {
+    GameState& state = *session.state;
+    std::ostream& out = *session.out;
+    Solver solver(state);
+    bool paused = false;
+
     while (true) {
-        // Display current game state
-        renderMap(state);
-        
-        // Check if solved
-        if (isSolved(state)) {
-            std::cout << "\n\033[1;32m🎉 CONGRATULATIONS! PUZZLE SOLVED! 🎉\033[0m\n";
-            std::cout << "\033[1;33mAll islands have the correct number of bridges!\033[0m\n";
-            break;
+        SolveStep step = solver.step();
+        if (solver.finished()) {
+            if (step.event == SolveEvent::Solved) {
+                std::vector<MoveRecord> moves = solver.appliedMoves();
+                session.history.insert(session.history.end(), moves.begin(), moves.end());
+                out << "\033[1;32mSolver finished in " << solver.steps() << " steps.\033[0m\n";
+            } else {
+                solver.rewind();
+                out << "\033[1;31mNo solution from this position (" << solver.steps()
+                    << " steps searched).\033[0m\n";
+            }
+            return;
         }
-        
-        std::cout << "\n\033[1;37mEnter command (or number for connection): \033[0m";
-        std::cin >> input;
-        
-        if (input == "q" || input == "quit") {
-            std::cout << "\033[1;33mThanks for playing!\033[0m\n";
-            break;
+        if (solver.steps() >= MAX_SOLVE_STEPS) {
+            solver.rewind();
+            out << "\033[1;31mSolver gave up after " << solver.steps()
+                << " steps; board restored.\033[0m\n";
+            return;
+        }
+
+        clearScreen(out);
+        renderMap(state, out, session.view);
+        describeStep(state, step, solver.steps(), out);
+        if (session.controlFd < 0) continue;
+        out << "\033[1;37m" << (paused ? "Paused" : "Solving") << " - 'p' + Enter to "
+            << (paused ? "resume" : "pause") << ", 'q' + Enter to stop\033[0m" << std::endl;
+
+        // Throttle, and take commands between frames; a paused solve sits
+        // here until the next line arrives
+        char command = readControl(session.controlFd, paused ? -1 : WATCH_FRAME_MS);
+        while (command == 'p' && !paused) {
+            paused = true;
+            out << "\033[1;37mPaused - 'p' + Enter to resume, 'q' + Enter to stop\033[0m" << std::endl;
+            command = readControl(session.controlFd, -1);
         }
-        else if (input == "m" || input == "menu") {
-            clearScreen();
-            printMenu();
+        if (command == 'p') paused = false;
+        if (command == 'q') {
+            solver.rewind();
+            out << "\033[1;33mSolver stopped; board restored.\033[0m\n";
+            return;
         }
-        else if (input == "c" || input == "connections") {
-            renderConnections(state);
+    }
+}
+
+bool dispatchCommand(ConsoleSession& session, const std::string& input) {
+    GameState& state = *session.state;
+    std::ostream& out = *session.out;
+
+    if (input == "q" || input == "quit") {
+        out << "\033[1;33mThanks for playing!\033[0m\n";
+        return false;
+    }
+    else if (input == "m" || input == "menu") {
+        clearScreen(out);
+        printMenu(out);
+    }
+    else if (input == "c" || input == "connections") {
+        renderConnections(state, out);
+    }
+    else if (input == "l" || input == "legal") {
+        renderConnections(state, out, true);
+    }
+    else if (input == "s" || input == "stats") {
+        renderStats(state, out);
+    }
+    else if (input == "p" || input == "profile") {
+        renderProfile(out);
+    }
+    else if (input == "up" || input == "\033[A") {
+        panViewport(state, session.view, -std::max(1, session.view.rows / 2), 0);
+    }
+    else if (input == "down" || input == "\033[B") {
+        panViewport(state, session.view, std::max(1, session.view.rows / 2), 0);
+    }
+    else if (input == "right" || input == "\033[C") {
+        panViewport(state, session.view, 0, std::max(1, session.view.cols / 2));
+    }
+    else if (input == "left" || input == "\033[D") {
+        panViewport(state, session.view, 0, -std::max(1, session.view.cols / 2));
+    }
+    else if (input == "w" || input == "watch") {
+        watchSolve(session);
+    }
+    else if (input == "u" || input == "undo") {
+        if (session.history.empty()) {
+            out << "\033[1;31mNothing to undo.\033[0m\n";
+        } else {
+            undoMove(state, session.history.back());
+            session.history.pop_back();
+            out << "\033[1;32mMove undone.\033[0m\n";
+        }
+    }
+    else if (input == "save") {
+        if (writeBinaryFile(SAVE_FILE, saveSnapshot(state))) {
+            out << "\033[1;32mProgress saved to " << SAVE_FILE << ".\033[0m\n";
+        } else {
+            out << "\033[1;31mCould not write " << SAVE_FILE << ".\033[0m\n";
         }
-        else if (input == "s" || input == "stats") {
-            renderStats(state);
+    }
+    else if (input == "load") {
+        std::vector<uint8_t> data;
+        if (!readBinaryFile(SAVE_FILE, data)) {
+            out << "\033[1;31mNo save file found.\033[0m\n";
+        } else if (!restoreSnapshot(state, data)) {
+            out << "\033[1;31mSave file does not match this level.\033[0m\n";
+        } else {
+            session.history.clear();
+            out << "\033[1;32mProgress restored.\033[0m\n";
         }
-        else {
-            // Try to parse as connection index
-            try {
-                int idx = std::stoi(input);
-                if (idx < 0 || idx >= static_cast<int>(state.connections.size())) {
-                    std::cout << "\033[1;31mInvalid connection ID. Use 'c' to see available connections.\033[0m\n";
+    }
+    else {
+        // Try to parse as connection index
+        try {
+            int idx = std::stoi(input);
+            if (idx < 0 || idx >= static_cast<int>(state.connections.size())) {
+                out << "\033[1;31mInvalid connection ID. Use 'c' to see available connections.\033[0m\n";
+            } else {
+                int previous = state.connections[idx].bridges;
+                if (!tryToggleBridge(state, idx)) {
+                    out << "\033[1;31mIllegal move! This would exceed an island's degree limit or cross a bridge.\033[0m\n";
                 } else {
-                    if (!tryToggleBridge(state, idx)) {
-                        std::cout << "\033[1;31mIllegal move! This would exceed an island's degree limit.\033[0m\n";
-                    } else {
-                        std::cout << "\033[1;32mBridge toggled successfully!\033[0m\n";
-                    }
+                    session.history.push_back({idx, previous});
+                    out << "\033[1;32mBridge toggled successfully!\033[0m\n";
                 }
-            } catch (const std::exception& e) {
-                std::cout << "\033[1;31mInvalid input. Type 'm' for menu or a connection number.\033[0m\n";
             }
+        } catch (const std::exception& e) {
+            out << "\033[1;31mInvalid input. Type 'm' for menu or a connection number.\033[0m\n";
         }
+    }
+    return true;
+}
+
+void runConsoleGame(GameState& state) {
+    ConsoleSession session{&state, &std::cout, {}, fitViewport(state, MAX_VIEW_ROWS, MAX_VIEW_COLS),
+                           STDIN_FILENO};
+    clearScreen(std::cout);
+    printMenu(std::cout);
+    
+    std::string input;
+    while (!renderTurn(session)) {
+        std::cout << "\n\033[1;37mEnter command (or number for connection): \033[0m";
+        if (!(std::cin >> input) || !dispatchCommand(session, input)) break;
         
         // Small pause for readability
-        std::cout << "\\nPress Enter to continue...";
+        std::cout << "\nPress Enter to continue...";
         std::cin.ignore();
         std::cin.get();
     }
-}
\ No newline at end of file
+}
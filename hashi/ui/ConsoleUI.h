@@ -1,4 +1,31 @@
 #pragma once
 #include "../model/GameState.h"
+#include "../engine/Moves.h"
+#include "../render/ConsoleRender.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Largest viewport the console opens with; bigger boards are panned
+const int MAX_VIEW_ROWS = 20;
+const int MAX_VIEW_COLS = 24;
+// Delay between frames while watching the solver
+const int WATCH_FRAME_MS = 150;
+
+// Per-player state the console keeps alongside the board
+struct ConsoleSession {
+    GameState* state;
+    std::ostream* out;
+    std::vector<MoveRecord> history;
+    Viewport view;
+    int controlFd = -1;   // polled for 'p'/'q' while the solver animates; -1 runs unthrottled
+    bool deadEnd = false; // the last rendered position was a dead end
+};
+
+// Shows the board; returns true (after congratulating) if it is solved
+bool renderTurn(ConsoleSession& session);
+
+// Executes one command exactly as typed at the prompt. Returns false on quit.
+bool dispatchCommand(ConsoleSession& session, const std::string& input);
 
 void runConsoleGame(GameState& state);
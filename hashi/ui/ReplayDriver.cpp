@@ -0,0 +1,96 @@
+#include "ReplayDriver.h"
+#include "ConsoleUI.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Groups latencies by what kind of command produced them
+std::string commandKind(const std::string& command) {
+    if (!command.empty() && std::all_of(command.begin(), command.end(),
+                                        [](unsigned char c) { return std::isdigit(c); }))
+        return "toggle";
+    if (command == "u" || command == "undo") return "undo";
+    if (command == "c" || command == "connections") return "connections";
+    if (command == "l" || command == "legal") return "legal";
+    if (command == "s" || command == "stats") return "stats";
+    if (command == "m" || command == "menu") return "menu";
+    if (command == "p" || command == "profile") return "profile";
+    if (command == "w" || command == "watch") return "watch";
+    return command;
+}
+
+double percentile(std::vector<double>& sorted, double fraction) {
+    size_t rank = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[rank];
+}
+
+} // namespace
+
+std::ostream& nullOutput() {
+    static NullBuffer buffer;
+    static std::ostream stream(&buffer);
+    return stream;
+}
+
+int runHeadlessReplay(GameState& state, std::istream& script,
+                      std::ostream& sink, std::ostream& report) {
+    ConsoleSession session{&state, &sink, {}, fitViewport(state, MAX_VIEW_ROWS, MAX_VIEW_COLS)};
+    std::map<std::string, std::vector<double>> latencies;
+    int commands = 0;
+    bool solved = false;
+
+    auto start = std::chrono::steady_clock::now();
+    std::string line;
+    while (std::getline(script, line)) {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') continue;
+
+        // One full turn: the command plus the redraw that follows it
+        auto turnStart = std::chrono::steady_clock::now();
+        bool keepGoing = dispatchCommand(session, line);
+        if (keepGoing) solved = renderTurn(session);
+        auto turnEnd = std::chrono::steady_clock::now();
+
+        latencies[commandKind(line)].push_back(
+            std::chrono::duration<double, std::micro>(turnEnd - turnStart).count());
+        commands++;
+        if (!keepGoing || solved) break;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    report << "Commands:   " << commands << (solved ? " (puzzle solved)" : "") << "\n";
+    report << "Elapsed:    " << seconds << " s\n";
+    report << "Throughput: " << (seconds > 0 ? commands / seconds : 0) << " commands/s\n\n";
+    report << std::setw(12) << "Command" << " | " << std::setw(7) << "Count"
+           << " | " << std::setw(10) << "Mean us" << " | " << std::setw(10) << "p50 us"
+           << " | " << std::setw(10) << "p99 us" << " | " << std::setw(10) << "Max us" << "\n";
+    report << std::string(74, '-') << "\n";
+    report << std::fixed << std::setprecision(2);
+    for (auto& entry : latencies) {
+        std::vector<double>& samples = entry.second;
+        std::sort(samples.begin(), samples.end());
+        double total = 0;
+        for (double s : samples) total += s;
+        report << std::setw(12) << entry.first << " | " << std::setw(7) << samples.size()
+               << " | " << std::setw(10) << total / samples.size()
+               << " | " << std::setw(10) << percentile(samples, 0.50)
+               << " | " << std::setw(10) << percentile(samples, 0.99)
+               << " | " << std::setw(10) << samples.back() << "\n";
+    }
+    report.unsetf(std::ios::fixed);
+    return commands;
+}
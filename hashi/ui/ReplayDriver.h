@@ -0,0 +1,18 @@
+#pragma once
+#include "../model/GameState.h"
+#include <iostream>
+
+// Feeds a recorded command script through the console's command dispatch
+// without a terminal: no prompts, no "Press Enter" pauses, and all game
+// output goes to `sink` (pass a null stream to discard it). Every command is
+// followed by the same board render and solved check as an interactive turn.
+//
+// Script format: one console command per line, exactly as typed at the
+// prompt; blank lines and lines starting with '#' are ignored.
+//
+// Timing results are written to `report`. Returns the number of commands run.
+int runHeadlessReplay(GameState& state, std::istream& script,
+                      std::ostream& sink, std::ostream& report);
+
+// A stream that formats everything and then throws it away
+std::ostream& nullOutput();